@@ -1,51 +1,319 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <string>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
 using namespace std;
 
+/**
+ * @brief Count how many times every byte value occurs in a buffer. The buffer is read 8 bytes at a
+ * time and the bytes are spread over 4 separate count tables, so runs of the same byte do not have
+ * to wait on each other to update one counter. The tables are summed every 2^30 bytes so they cannot overflow.
+ * 
+ * @param data Start of the buffer.
+ * @param length Number of bytes in the buffer.
+ * @return array<long, 256> with the count of every byte value.
+ */
+array<long, 256> byte_histogram(const char* data, size_t length) {
+    array<long, 256> histogram{};
+    const size_t BLOCK_SIZE = (size_t) 1 << 30;
+    vector<uint32_t> counts(4 * 256);
+    while(length > 0) {
+        size_t block = min(length, BLOCK_SIZE);
+        fill(counts.begin(), counts.end(), 0);
+        size_t i = 0;
+        for(; i + 8 <= block; i += 8) {
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            counts[0 * 256 + (word & 0xff)]++;
+            counts[1 * 256 + ((word >> 8) & 0xff)]++;
+            counts[2 * 256 + ((word >> 16) & 0xff)]++;
+            counts[3 * 256 + ((word >> 24) & 0xff)]++;
+            counts[0 * 256 + ((word >> 32) & 0xff)]++;
+            counts[1 * 256 + ((word >> 40) & 0xff)]++;
+            counts[2 * 256 + ((word >> 48) & 0xff)]++;
+            counts[3 * 256 + (word >> 56)]++;
+        }
+        for(; i < block; i++) {
+            counts[(unsigned char) data[i]]++;
+        }
+        for(int c = 0; c < 256; c++) {
+            histogram[c] += counts[c] + counts[256 + c] + counts[2 * 256 + c] + counts[3 * 256 + c];
+        }
+        data += block;
+        length -= block;
+    }
+    return histogram;
+}
+
+
+const int LETTERS = 26;
+
+/**
+ * @brief Index of all animals bucketed on their first and last letter, built once and then used for
+ * any number of queries. Animals with the same first and last letter are interchangeable in the game,
+ * so a query only has to look at the 26 buckets starting with the given letter.
+ */
+class AnimalIndex {
+public:
+    /**
+     * @brief Construct a new Animal Index object
+     * 
+     * @param animals All animals that can still be used, in input order.
+     */
+    AnimalIndex(vector<string> animals) : animals(move(animals)) {
+        buckets = vector<vector<int>>(LETTERS * LETTERS);
+        pair_counts = vector<int>(LETTERS * LETTERS, 0);
+        string first_chars(this->animals.size(), ' ');
+        for(int id = 0; id < (int) this->animals.size(); id++) {
+            const string& animal = this->animals[id];
+            first_chars[id] = animal[0];
+            // Ids are added in increasing order so every bucket starts with its first animal
+            int bucket = letter(animal[0]) * LETTERS + letter(animal.back());
+            buckets[bucket].push_back(id);
+            pair_counts[bucket]++;
+        }
+        for(int bucket = 0; bucket < LETTERS * LETTERS; bucket++) {
+            if(pair_counts[bucket] > 0) {
+                used_buckets.push_back(bucket);
+            }
+        }
+        // Memo entries that fit in MEMO_BYTES, every entry is a key and around 96 bytes of hash table and allocation
+        max_states = max<size_t>(1, MEMO_BYTES / (1 + sizeof(int) * used_buckets.size() + 96));
+        array<long, 256> histogram = byte_histogram(first_chars.data(), first_chars.size());
+        for(int c = 0; c < LETTERS; c++) {
+            first_counts[c] = histogram['a' + c];
+        }
+    }
+
+    /**
+     * @brief Find the first animal that can follow an animal ending with last_char, preferring the first
+     * one that leaves no animal starting with its own last letter. Has time complexity O(26).
+     * 
+     * @param last_char Last character of the previous animal.
+     * @return pair<int, bool> of animal id (-1 if none can follow) and if it eliminates the opponent.
+     */
+    pair<int, bool> find_move(char last_char) const {
+        int first = letter(last_char);
+        int first_id = -1;
+        int eliminating_id = -1;
+        for(int last = 0; last < LETTERS; last++) {
+            const vector<int>& bucket = buckets[first * LETTERS + last];
+            if(bucket.empty()) {
+                continue;
+            }
+            int id = bucket[0];
+            if(first_id == -1 || id < first_id) {
+                first_id = id;
+            }
+            // Using this animal removes one that starts with first
+            int left = first_counts[last] - (last == first ? 1 : 0);
+            if(left == 0 && (eliminating_id == -1 || id < eliminating_id)) {
+                eliminating_id = id;
+            }
+        }
+        if(eliminating_id != -1) {
+            return {eliminating_id, true};
+        }
+        return {first_id, false};
+    }
+
+    /**
+     * @brief Play the whole game with perfect play from both sides (minimax). The state of the game is
+     * the number of unused animals for every (first, last) letter pair in use and the letter to continue
+     * from, states are memoized between queries. The number of states is up to 26 times the product of
+     * (animals + 1) over the pairs in use, so it grows with how many animals share a pair and not only
+     * with the letter graph (the game is edge geography, which is PSPACE-complete). The search is bounded
+     * by the memo size (MEMO_BYTES), when that runs out the answer of find_move is given instead, where
+     * '!' still means a sure win since the opponent has no animal left.
+     * 
+     * @param last_char Last character of the previous animal.
+     * @return pair<int, bool> of animal id (-1 if none can follow) and if it wins the game.
+     */
+    pair<int, bool> find_winning_move(char last_char) {
+        int first = letter(last_char);
+        int first_id = -1;
+        for(int last = 0; last < LETTERS; last++) {
+            int bucket = first * LETTERS + last;
+            if(pair_counts[bucket] == 0) {
+                continue;
+            }
+            int id = buckets[bucket][0];
+            if(first_id == -1 || id < first_id) {
+                first_id = id;
+            }
+        }
+        // First animal in input order that leaves the opponent in a losing state
+        int winning_id = -1;
+        for(int last = 0; last < LETTERS; last++) {
+            int bucket = first * LETTERS + last;
+            if(pair_counts[bucket] == 0) {
+                continue;
+            }
+            pair_counts[bucket]--;
+            int opponent_wins = wins(last);
+            pair_counts[bucket]++;
+            if(opponent_wins == UNKNOWN) {
+                return find_move(last_char);
+            }
+            int id = buckets[bucket][0];
+            if(!opponent_wins && (winning_id == -1 || id < winning_id)) {
+                winning_id = id;
+            }
+        }
+        if(winning_id != -1) {
+            return {winning_id, true};
+        }
+        return {first_id, false};
+    }
 
-int main(){
+    /**
+     * @brief Get the name of an animal.
+     * 
+     * @param id 
+     * @return const string& name.
+     */
+    const string& animal(int id) const {
+        return animals[id];
+    }
+
+private:
+    vector<string> animals;
+    // Animal ids for every (first, last) pair, at first * LETTERS + last
+    vector<vector<int>> buckets;
+    // Unused animals for every (first, last) pair, changed while searching the game tree
+    vector<int> pair_counts;
+    array<int, LETTERS> first_counts{};
+    // Pairs with any animals, the only counts that are part of a state
+    vector<int> used_buckets;
+    unordered_map<string, bool> memo;
+    size_t max_states;
+
+    // Memory for the memo of find_winning_move
+    static constexpr size_t MEMO_BYTES = (size_t) 1 << 26;
+    static constexpr int UNKNOWN = -1;
+
+    static int letter(char c) {
+        return c - 'a';
+    }
+
+    /**
+     * @brief Key of the current state: the letter to continue from and the counts of the used pairs.
+     */
+    string state_key(int first) const {
+        string key(1, (char) first);
+        for(int bucket : used_buckets) {
+            key.append((const char*) &pair_counts[bucket], sizeof(int));
+        }
+        return key;
+    }
+
+    /**
+     * @brief Check if the player that has to continue from letter first wins with perfect play. The game
+     * tree is searched depth first with an explicit stack, a game can be as long as there are animals.
+     * 
+     * @param first Letter to continue from.
+     * @return int 1 if the player to move wins, 0 if not, UNKNOWN if the memo is full.
+     */
+    int wins(int first) {
+        auto it = memo.find(state_key(first));
+        if(it != memo.end()) {
+            return it->second;
+        }
+        // Letter to continue from and the last letter of the move being tried, for every level
+        vector<pair<int, int>> stack{{first, -1}};
+        bool child_wins = false;
+        bool returning = false;
+        while(!stack.empty()) {
+            int level = stack.size() - 1;
+            int from = stack[level].first;
+            if(returning) {
+                pair_counts[from * LETTERS + stack[level].second]++;
+                returning = false;
+                // A move wins if the opponent loses afterwards
+                if(!child_wins) {
+                    memo[state_key(from)] = true;
+                    stack.pop_back();
+                    child_wins = true;
+                    returning = true;
+                    continue;
+                }
+            }
+            int last = stack[level].second + 1;
+            while(last < LETTERS && pair_counts[from * LETTERS + last] == 0) {
+                last++;
+            }
+            if(last == LETTERS) {
+                memo[state_key(from)] = false;
+                stack.pop_back();
+                child_wins = false;
+                returning = true;
+                continue;
+            }
+            stack[level].second = last;
+            pair_counts[from * LETTERS + last]--;
+            auto found = memo.find(state_key(last));
+            if(found != memo.end()) {
+                child_wins = found->second;
+                returning = true;
+            } else if(memo.size() + stack.size() >= max_states) {
+                // Out of memory for states, undo the moves on the stack
+                for(const pair<int, int>& move : stack) {
+                    pair_counts[move.first * LETTERS + move.second]++;
+                }
+                return UNKNOWN;
+            } else {
+                stack.push_back({last, -1});
+            }
+        }
+        return child_wins;
+    }
+};
+
+/**
+ * @brief Print the answer for a move: the animal with '!' if it eliminates (or wins against) the opponent,
+ * the first possible animal otherwise and '?' if there is none.
+ * 
+ * @param index 
+ * @param choice Pair of animal id and if it eliminates the opponent.
+ */
+void print_move(const AnimalIndex& index, pair<int, bool> choice) {
+    if(choice.first == -1) {
+        cout << "?\n";
+    } else if(choice.second) {
+        cout << index.animal(choice.first) << '!' << "\n";
+    } else {
+        cout << index.animal(choice.first) << "\n";
+    }
+}
+
+int main(int argc, char* argv[]){
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
     cout.tie(NULL);
 
+    // "solve" plays the whole game instead of only looking one move ahead
+    bool solve_game = argc > 1 && string(argv[1]) == "solve";
+
     string prev_animal;
     int choices_left;
     cin >> prev_animal >> choices_left;
 
-    vector<int> chars_first(26, 0);
-    vector<string> potential_animals;
-    string next_animal;
+    vector<string> animals(choices_left);
     for(int i = 0; i < choices_left; i++) {
-        cin >> next_animal;
-        if(next_animal[0] == prev_animal.back()) {
-            potential_animals.push_back(next_animal);
-        }
-        // Increace the count for this first character of the string
-        int char_num = ((int) next_animal[0] - 97);
-        chars_first[char_num] += 1;
+        cin >> animals[i];
     }
+    AnimalIndex index(move(animals));
 
-    if(potential_animals.size() == 0){
-        cout << "?\n";
-    } else {
-        string output_animal = "unknown";
-        for(auto animal : potential_animals) {
-            // check if there is a case where last char not existing as first char.
-            int char_num_back = ((int) animal.back() - 97);
-            int char_num_front = ((int) animal[0] - 97);
-            chars_first[char_num_front] -= 1;
-
-            if(chars_first[char_num_back] == 0) {
-                output_animal = animal;
-                break;
-            }
-            chars_first[char_num_front] += 1;
-        }
-        if(output_animal == "unknown") {
-            cout << potential_animals[0] << "\n";
+    // Any previous animals after the list are answered against the same index
+    do {
+        if(solve_game) {
+            print_move(index, index.find_winning_move(prev_animal.back()));
         } else {
-            cout << output_animal << '!' << "\n";
+            print_move(index, index.find_move(prev_animal.back()));
         }
-    }
-}
\ No newline at end of file
+    } while(cin >> prev_animal);
+}
@@ -1,87 +1,231 @@
 #include <iostream>
 #include <vector>
-#include <sstream>
+#include <string>
 #include <iterator>
-#include <array>
-#include <set>
+#include <cctype>
 using namespace std;
 
 
+/**
+ * @brief Read the next integer from the buffer.
+ *
+ * @param buffer
+ * @param pos Position in buffer, moved past the integer.
+ * @param number Set to the integer.
+ * @return true if an integer was read,
+ * @return false at the end of the buffer.
+ */
+bool read_int(const string& buffer, size_t& pos, long& number) {
+    while(pos < buffer.size() && isspace((unsigned char) buffer[pos])) {
+        pos++;
+    }
+    if(pos == buffer.size()) {
+        return false;
+    }
+    bool negative = buffer[pos] == '-';
+    if(negative) {
+        pos++;
+    }
+    number = 0;
+    while(pos < buffer.size() && isdigit((unsigned char) buffer[pos])) {
+        number = number * 10 + (buffer[pos] - '0');
+        pos++;
+    }
+    if(negative) {
+        number = -number;
+    }
+    return true;
+}
+
+/**
+ * @brief Compute the U list (the removed leaves) from the V list in O(N). A leaf is always the smallest
+ * node with degree 0 (not in the rest of the V list). ptr goes up through the nodes once: when removing
+ * a leaf makes its neighbour a leaf that is smaller than ptr, it is the smallest leaf and is taken next,
+ * otherwise ptr moves on to the next node with degree 0.
+ *
+ * @param v V list with nodes 1 to N + 1.
+ * @return vector<int> U list, empty if V is not a valid list.
+ */
+vector<int> decode(const vector<int>& v) {
+    int num_nodes = v.size();
+    // The last node has to be the biggest node, and it is never removed
+    if(num_nodes == 0 || v.back() != num_nodes + 1) {
+        return {};
+    }
+    vector<int> degree(num_nodes + 2, 0);
+    for(int node : v) {
+        degree[node]++;
+    }
+
+    vector<int> u(num_nodes);
+    int ptr = 1;
+    while(degree[ptr] != 0) {
+        ptr++;
+    }
+    int leaf = ptr;
+    for(int k = 0; k < num_nodes; k++) {
+        u[k] = leaf;
+        int neighbour = v[k];
+        degree[neighbour]--;
+        if(degree[neighbour] == 0 && neighbour < ptr) {
+            leaf = neighbour;
+        } else {
+            ptr++;
+            while(ptr <= num_nodes + 1 && degree[ptr] != 0) {
+                ptr++;
+            }
+            leaf = ptr;
+        }
+    }
+    return u;
+}
+
+/**
+ * @brief Compute the V list of a tree with nodes 1 to N + 1 in O(N), used to test decode. The tree is
+ * rooted in node N + 1 so the neighbour of a removed leaf is its parent, then leaves are removed
+ * smallest first with the same pointer technique as decode.
+ *
+ * @param edges The N edges of the tree.
+ * @return vector<int> V list, empty if the edges are not a tree.
+ */
+vector<int> encode(const vector<pair<int, int>>& edges) {
+    int num_nodes = edges.size();
+    int root = num_nodes + 1;
+    // Neighbours of every node grouped per node
+    vector<int> edge_start(num_nodes + 3, 0);
+    for(const pair<int, int>& edge : edges) {
+        edge_start[edge.first + 1]++;
+        edge_start[edge.second + 1]++;
+    }
+    for(int node = 1; node <= num_nodes + 2; node++) {
+        edge_start[node] += edge_start[node - 1];
+    }
+    vector<int> neighbours(2 * num_nodes);
+    vector<int> fill_pos(edge_start.begin(), edge_start.end());
+    for(const pair<int, int>& edge : edges) {
+        neighbours[fill_pos[edge.first]++] = edge.second;
+        neighbours[fill_pos[edge.second]++] = edge.first;
+    }
+
+    // Parent of every node when rooted at the biggest node
+    vector<int> parent(num_nodes + 2, 0);
+    vector<int> stack{root};
+    parent[root] = -1;
+    int visited = 0;
+    while(!stack.empty()) {
+        int node = stack.back();
+        stack.pop_back();
+        visited++;
+        for(int i = edge_start[node]; i < edge_start[node + 1]; i++) {
+            int next = neighbours[i];
+            if(next != parent[node]) {
+                if(parent[next] != 0) {
+                    return {};
+                }
+                parent[next] = node;
+                stack.push_back(next);
+            }
+        }
+    }
+    if(visited != num_nodes + 1) {
+        return {};
+    }
+
+    // Children left of every node, a node is a leaf when it has none
+    vector<int> degree(num_nodes + 2, 0);
+    for(int node = 1; node <= num_nodes; node++) {
+        degree[parent[node]]++;
+    }
+    vector<int> v(num_nodes);
+    int ptr = 1;
+    while(degree[ptr] != 0) {
+        ptr++;
+    }
+    int leaf = ptr;
+    for(int k = 0; k < num_nodes; k++) {
+        int next = parent[leaf];
+        v[k] = next;
+        degree[next]--;
+        if(degree[next] == 0 && next < ptr) {
+            leaf = next;
+        } else {
+            ptr++;
+            while(ptr <= num_nodes && degree[ptr] != 0) {
+                ptr++;
+            }
+            leaf = ptr;
+        }
+    }
+    return v;
+}
+
 /**
  * @brief Main function, takes input from terminal and outputs answer to terminal.
- * Takes a V list and tries to compute the U list.
+ * Takes a V list and tries to compute the U list. With "encode" as argument it instead takes
+ * N and the N edges of a tree and outputs its V list.
  *
  * @return int
  */
-int main() {
+int main(int argc, char* argv[]) {
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
-    string input;
-    getline(cin, input);
-    int num_nodes = stoi(input);
+    bool encode_tree = argc > 1 && string(argv[1]) == "encode";
 
-    // No input got
-    if(num_nodes == 0) {
-        cout << "Error" << "\n";
+    string input(istreambuf_iterator<char>(cin), {});
+    size_t pos = 0;
+    long num_nodes = 0;
+    read_int(input, pos, num_nodes);
+
+    string output;
+    if(encode_tree) {
+        vector<pair<int, int>> edges(num_nodes);
+        for(pair<int, int>& edge : edges) {
+            long first = 0, second = 0;
+            read_int(input, pos, first);
+            read_int(input, pos, second);
+            // Nodes outside 1 to N + 1 cannot be in the tree
+            if(first < 1 || first > num_nodes + 1 || second < 1 || second > num_nodes + 1) {
+                cout << "Error" << "\n";
+                return 0;
+            }
+            edge = {(int) first, (int) second};
+        }
+        vector<int> v = encode(edges);
+        if(num_nodes == 0 || v.empty()) {
+            cout << "Error" << "\n";
+            return 0;
+        }
+        for(int node : v) {
+            output += to_string(node);
+            output += '\n';
+        }
+        cout << output;
         return 0;
     }
 
-    // Make basic lists
-    vector<int> degree(num_nodes+1);
-    vector<int> v(num_nodes);
-
-    // Take out numbers from terminal and put them in degree and v.
+    // Take out numbers from terminal and put them in v.
+    vector<int> v(max(num_nodes, 0L));
     for(int i = 0; i < num_nodes; i++) {
-        getline(cin, input);
-        int curr_node = stoi(input);
-
-        // We have a bigger input than should exist
-        if(curr_node > (num_nodes + 1)) {
+        long curr_node = 0;
+        read_int(input, pos, curr_node);
+        // We have a bigger (or smaller) input than should exist
+        if(curr_node > (num_nodes + 1) || curr_node < 1) {
             cout << "Error" << "\n";
             return 0;
         }
-
-        // Add to v
         v[i] = curr_node;
-
-        // Add to degrees (-1 for index starts at 0)
-        int deg_index = curr_node - 1;
-        degree[deg_index] += 1;
-
     }
 
-    // Last element in the input stream is not the biggest node.
-    if(v[v.size()-1] != (num_nodes + 1)) {
+    // No input got or last element in the input stream is not the biggest node.
+    vector<int> u = decode(v);
+    if(u.empty()) {
         cout << "Error" << "\n";
         return 0;
     }
-
-    // Insert leaves (nodes that have degree 0)
-    set<int> leaves; // Set sorts leaves, smallest leaf first
-    for(unsigned i = 0; i < degree.size(); i ++) {
-        if(degree[i] == 0){
-            leaves.insert(i);
-        }
-    }
-
-    // Make the u list
-    int k = 0;
-    while(leaves.size() != 0 && k < num_nodes) {
-        // Take top (smalles) leaf and remove it from leaves
-        int top_leaf = *leaves.begin();
-        leaves.erase(top_leaf);
-
-        // Print smallest leaf
-        cout << to_string(top_leaf + 1) << "\n";
-        // Get new degree
-        int upd_deg = degree[v[k]-1] - 1;
-        // Update leaves if needed
-        if(upd_deg == 0) {
-            leaves.insert(v[k]-1);
-        }
-        // Update degree list
-        degree[v[k]-1] = upd_deg;
-        k++;
+    for(int leaf : u) {
+        output += to_string(leaf);
+        output += '\n';
     }
+    cout << output;
     return 0 ;
-}
\ No newline at end of file
+}
@@ -2,10 +2,155 @@
 #include <vector>
 #include <algorithm>
 #include <string>
-#include <map>
-#include <unordered_map>
+#include <array>
+#include <cstdint>
+#include <cstring>
 using namespace std;
 
+/**
+ * @brief Count how many times every byte value occurs in a buffer. The buffer is read 8 bytes at a
+ * time and the bytes are spread over 4 separate count tables, so runs of the same byte do not have
+ * to wait on each other to update one counter. The tables are summed every 2^30 bytes so they cannot overflow.
+ * 
+ * @param data Start of the buffer.
+ * @param length Number of bytes in the buffer.
+ * @return array<long, 256> with the count of every byte value.
+ */
+array<long, 256> byte_histogram(const char* data, size_t length) {
+    array<long, 256> histogram{};
+    const size_t BLOCK_SIZE = (size_t) 1 << 30;
+    vector<uint32_t> counts(4 * 256);
+    while(length > 0) {
+        size_t block = min(length, BLOCK_SIZE);
+        fill(counts.begin(), counts.end(), 0);
+        size_t i = 0;
+        for(; i + 8 <= block; i += 8) {
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            counts[0 * 256 + (word & 0xff)]++;
+            counts[1 * 256 + ((word >> 8) & 0xff)]++;
+            counts[2 * 256 + ((word >> 16) & 0xff)]++;
+            counts[3 * 256 + ((word >> 24) & 0xff)]++;
+            counts[0 * 256 + ((word >> 32) & 0xff)]++;
+            counts[1 * 256 + ((word >> 40) & 0xff)]++;
+            counts[2 * 256 + ((word >> 48) & 0xff)]++;
+            counts[3 * 256 + (word >> 56)]++;
+        }
+        for(; i < block; i++) {
+            counts[(unsigned char) data[i]]++;
+        }
+        for(int c = 0; c < 256; c++) {
+            histogram[c] += counts[c] + counts[256 + c] + counts[2 * 256 + c] + counts[3 * 256 + c];
+        }
+        data += block;
+        length -= block;
+    }
+    return histogram;
+}
+
+class FenwickTree {
+public:
+    /**
+     * @brief Construct a new Fenwick Tree object
+     * 
+     * @param fenwick_length length of fenwicktree.
+     */
+    FenwickTree(const int fenwick_length) {
+        // Fenwick structure start at intiger 1 instead of 0
+        fenwick_tree = vector<long>(fenwick_length + 1, 0);
+    }
+
+    /**
+     * @brief Sum all elements up to index index (exclusive). Has time complexity O(log(N)).
+     *
+     * @param index Index to be summed up to.
+     * @return long that is summation of all values before index.
+     */
+    long sum_fenwick(int index) {
+        long sum = 0;
+        while(index > 0) {
+            sum += fenwick_tree[index];
+            // Flip the lowest significant 1 to a 0. This acts as going to a lower layer of the tree.
+            index -= (index & (-index));
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Update the fenwick tree by adding a value to position index. Has time complexity O(log(N)).
+     *
+     * @param index Index that is to be updated.
+     * @param add_value Value that is to be added on in position Index.
+     */
+    void update_fenwick(int index, long add_value) {
+        // Increment index because fenwick starts at index 1 not 0
+        index++;
+        while(index < (int) fenwick_tree.size()) {
+            fenwick_tree[index] += add_value;
+            // Step to a higher layer that uses sum of position current index.
+            index += (index & (-index));
+        }
+    }
+
+private:
+    vector<long> fenwick_tree;
+};
+
+/**
+ * @brief Minimum number of adjacent swaps to make s a palindrome, s must have at most one odd character count.
+ * Going from the left, every unpaired character is paired with the rightmost unpaired occurrence of the
+ * same character (kept in a queue of positions per character). The left one gets the next free position
+ * from the left, the right one the mirrored position and the odd middle character gets the center.
+ * The number of swaps is then the number of inversions in the target positions, counted with a
+ * fenwick tree. Gives the same answer as bubbling characters to the right end but in O(Nlog(N)).
+ * 
+ * @param s 
+ * @return long number of swaps.
+ */
+long min_palindrome_swaps(const string& s) {
+    int length = s.size();
+    // Positions of every character in increasing order, used as a queue from both ends
+    vector<vector<int>> positions(256);
+    for(int i = 0; i < length; i++) {
+        positions[(unsigned char) s[i]].push_back(i);
+    }
+    vector<int> front(256, 0);
+    vector<int> back(256);
+    for(int c = 0; c < 256; c++) {
+        back[c] = (int) positions[c].size() - 1;
+    }
+
+    vector<int> target(length, -1);
+    int left_fixed = 0;
+    for(int i = 0; i < length; i++) {
+        if(target[i] != -1) {
+            continue;
+        }
+        unsigned char c = s[i];
+        // i is always the first unpaired occurrence of its character
+        front[c]++;
+        if(front[c] > back[c]) {
+            // No occurrence left to pair with, the odd character goes in the middle
+            target[i] = length / 2;
+            continue;
+        }
+        int pair_pos = positions[c][back[c]];
+        back[c]--;
+        target[i] = left_fixed;
+        target[pair_pos] = length - 1 - left_fixed;
+        left_fixed++;
+    }
+
+    // Count inversions, for every position how many to the right must end up before it
+    long num_swaps = 0;
+    FenwickTree fenwick_tree(length);
+    for(int i = length - 1; i >= 0; i--) {
+        num_swaps += fenwick_tree.sum_fenwick(target[i]);
+        fenwick_tree.update_fenwick(target[i], 1);
+    }
+    return num_swaps;
+}
+
 
 int main(){
     ios_base::sync_with_stdio(false);
@@ -17,13 +162,10 @@ int main(){
     for(int test = 0; test < test_cases; test++) {
         string s;
         cin >> s;
-        unordered_map<char, int> freq;
-        for(char c : s) {
-            freq[c]++;
-        }
+        array<long, 256> freq = byte_histogram(s.data(), s.size());
         int odd_count = 0;
-        for(auto it = freq.begin(); it != freq.end(); it++) {
-            if(it->second % 2 != 0) {
+        for(long count : freq) {
+            if(count % 2 != 0) {
                 odd_count++;
             }
         }
@@ -32,33 +174,6 @@ int main(){
             continue;
         }
 
-        int left_fixed = 0;
-        int right_fixed = s.size() - 1;
-        int num_swaps = 0;
-        vector<char> word(s.begin(), s.end());
-
-        while(left_fixed < right_fixed) {
-            int right_pointer = right_fixed;
-            while(word[right_pointer] != word[left_fixed]) {
-                right_pointer--;
-            }
-            if(right_pointer == left_fixed) {
-                char temp = word[right_pointer];
-                word[right_pointer] = word[right_pointer + 1];
-                word[right_pointer + 1] = temp;
-                num_swaps++;
-                continue;
-            }
-            while(right_pointer < right_fixed) {
-                char temp = word[right_pointer];
-                word[right_pointer] = word[right_pointer + 1];
-                word[right_pointer + 1] = temp;
-                num_swaps++;
-                right_pointer++;
-            }
-            right_fixed--;
-            left_fixed++;
-        }
-        cout << num_swaps << "\n";
+        cout << min_palindrome_swaps(s) << "\n";
     }
 }
\ No newline at end of file
@@ -17,6 +17,24 @@
 #include <iomanip>
 using namespace std;
 
+struct Point {
+    double x;
+    double y;
+};
+
+/**
+ * @brief Squared distance between two points, the edges are sorted on this.
+ *
+ * @param a
+ * @param b
+ * @return double
+ */
+double squared_distance(Point a, Point b) {
+    double dx = a.x - b.x;
+    double dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
 /**
  * @brief Recursive find of root node for a integer in a collection of (disjoint) sets.
  * 
@@ -112,15 +130,15 @@ bool compare_lexicographic(pair<int, int> edge1, pair<int, int> edge2) {
 }
 
 /**
- * @brief Find what edges make minimal spanning tree (least cost) if any exist and its cost, 
- * using a set of edges and kruskals algorithm. 
+ * @brief Find what edges make minimal spanning tree (least cost) if any exist, using a set of edges
+ * sorted on cost and kruskals algorithm. 
  * 
- * @param edges Edges in given graph.
+ * @param edges Edges in given graph, sorted on cost.
  * @param num_nodes Number of nodes in the graph.
- * @return pair<int, vector<pair<int, int>>>: total_tree_cost, edges in tree (lexicographic order). 
+ * @return vector<pair<int, int>>: edges in tree (lexicographic order). 
  * Vector will be length 1 with (-1, -1) if no tree is made.
  */
-pair<double, vector<pair<int, int>>> kruskals(vector<pair<double, pair<int, int>>>& edges, int num_nodes) {
+vector<pair<int, int>> kruskals(vector<pair<double, pair<int, int>>>& edges, int num_nodes) {
 
     // Initialize parent nodes and sizes of disjoint unions
     vector<int> parents(num_nodes);
@@ -128,24 +146,21 @@ pair<double, vector<pair<int, int>>> kruskals(vector<pair<double, pair<int, int>
     vector<int> union_sizes(num_nodes, 1);
 
     vector<pair<int, int>> connections_made;
-    double total_path_cost = 0;
     int curr_index = 0;
     while(curr_index < edges.size()) {
         pair<double, pair<int, int>> new_edge = edges[curr_index];
         //edges.erase(new_edge);
         int first_node = (new_edge.second).first;
         int second_node = (new_edge.second).second;
-        double cost = new_edge.first;
         //not in set, check both from and to index
         if(!find(parents, first_node, second_node)) {
-            // add to set (both of the nodes), add cost to total_path_cost
+            // add to set (both of the nodes)
             merge_unions(parents, union_sizes, first_node, second_node);
             if(first_node < second_node) {
                 connections_made.push_back({first_node, second_node});
             } else {
                 connections_made.push_back({second_node, first_node});
             }
-            total_path_cost += cost;
         }
         curr_index++;
     }
@@ -153,19 +168,14 @@ pair<double, vector<pair<int, int>>> kruskals(vector<pair<double, pair<int, int>
     // Check if all nodes are in the same set (all nodes connected)
     int root = find_root(parents, 0);
     if(union_sizes[root] != num_nodes) {
-        return {-1, vector<pair<int, int>>(1, {-1, -1})};
+        return vector<pair<int, int>>(1, {-1, -1});
     }
     
     // Sort in lexicographic order
     sort(connections_made.begin(), connections_made.end(), compare_lexicographic);
-    return {total_path_cost, connections_made};
+    return connections_made;
 }
 
-double pythagoras(pair<double, double> node1, pair<double, double> node2) {
-    return sqrt(pow(node1.first - node2.first, 2) + pow(node1.second - node2.second, 2));
-}
-
-
 /**
  * @brief Execute program (minimal spanning tree) and takes inputs/ outputs from console.
  * 
@@ -184,13 +194,14 @@ int main() {
         }
         int num_nodes;
         cin >> num_nodes;
-        vector<pair<double, double>> nodes(num_nodes);
+        vector<Point> nodes(num_nodes);
         for(int node = 0; node < num_nodes; node++) {
             double x_pos, y_pos;
             cin >> x_pos >> y_pos;
             nodes[node] = {x_pos, y_pos};
         }
-        // Init edges, set of edges: cost, (from - to)
+        // Init edges, set of edges: squared cost, (from - to). Sorting on squared distances gives the same
+        // order, so sqrt is only taken for the edges in the tree
         vector<pair<double, pair<int, int>>> edges;
         for(int column = 0; column < num_nodes; column++) {
             int row = column+1;
@@ -198,20 +209,20 @@ int main() {
                 if(column == row) {
                     continue;
                 }
-                double dist = pythagoras(nodes[column], nodes[row]);
-                //cout << dist << endl;
-                edges.push_back({dist, {column, row}});
+                edges.push_back({squared_distance(nodes[column], nodes[row]), {column, row}});
                 row++;
             }
         }
         sort(edges.begin(), edges.end());
         // Output from kruskals
+        // The real cost of the tree is the sum of the real lengths of its edges
         double total_cost = 0;
-        vector<pair<int, int>> connections;
-        pair<double, vector<pair<int, int>>> result_from_kruskal = kruskals(edges, num_nodes);
+        vector<pair<int, int>> connections = kruskals(edges, num_nodes);
         //cout << "it broke" << endl;
         // Ending prints
-        total_cost = result_from_kruskal.first;
+        for(pair<int, int> connection : connections) {
+            total_cost += sqrt(squared_distance(nodes[connection.first], nodes[connection.second]));
+        }
         cout << std::fixed << setprecision(2) << total_cost << "\n";
     }
 }
\ No newline at end of file
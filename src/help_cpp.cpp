@@ -1,123 +1,331 @@
 #include <iostream>
 #include <vector>
-#include <sstream>
 #include <iterator>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <cctype>
+#include <algorithm>
 using namespace std;
 
-enum Swap_case { do_nothing, swap_first, swap_second, not_same };
+/**
+ * @brief Read all of standard input into one buffer, tokens are then views into this buffer.
+ *
+ * @return string with the whole input.
+ */
+string read_input() {
+    return string(istreambuf_iterator<char>(cin), istreambuf_iterator<char>());
+}
 
 /**
- * @brief Seperates a input string with spaces into a vector.
+ * @brief Take the next line from the front of the buffer (without the newline).
+ *
+ * @param buffer Remaining input, moved forward past the line.
+ * @return string_view of the line.
+ */
+string_view next_line(string_view& buffer) {
+    size_t end = buffer.find('\n');
+    string_view line = buffer.substr(0, end);
+    buffer.remove_prefix(end == string_view::npos ? buffer.size() : end + 1);
+    return line;
+}
+
+/**
+ * @brief Seperates a string on whitespace without copying, the views point into str.
  *
  * @param str
- * @return vector<string>
+ * @return vector<string_view> of every word in str.
  */
-vector<string> separate_string (string str) {
-    stringstream ss{str};
-    // Iterates over ss and puts every word into a vector<string> (through constructor)
-    return { istream_iterator<string>{ ss }, istream_iterator<string>{}  };
+vector<string_view> tokenize(string_view str) {
+    vector<string_view> tokens;
+    size_t i = 0;
+    while(i < str.size()) {
+        while(i < str.size() && isspace((unsigned char) str[i])) {
+            i++;
+        }
+        size_t start = i;
+        while(i < str.size() && !isspace((unsigned char) str[i])) {
+            i++;
+        }
+        if(i > start) {
+            tokens.push_back(str.substr(start, i - start));
+        }
+    }
+    return tokens;
 }
 
+/**
+ * @brief Maps tokens to dense ids (0, 1, 2, ... in order of first appearance). The text of every token
+ * is copied once into large arena blocks and looked up through a flat open-addressing hash table
+ * with linear probing, so no node or string is allocated per token.
+ */
+class Interner {
+public:
+    Interner() {
+        table = vector<int>(16, -1);
+    }
+
+    /**
+     * @brief Get the id of a token, adding it if it has not been seen before.
+     *
+     * @param token
+     * @return int id of the token.
+     */
+    int intern(string_view token) {
+        uint32_t hash = hash_token(token);
+        size_t mask = table.size() - 1;
+        size_t slot = hash & mask;
+        while(table[slot] != -1) {
+            int id = table[slot];
+            if(hashes[id] == hash && tokens[id] == token) {
+                return id;
+            }
+            slot = (slot + 1) & mask;
+        }
+        int id = tokens.size();
+        tokens.push_back(store(token));
+        hashes.push_back(hash);
+        table[slot] = id;
+        // Keep the table at most half full so probes stay short
+        if(tokens.size() * 2 > table.size()) {
+            grow();
+        }
+        return id;
+    }
+
+    /**
+     * @brief Get the text of a token.
+     *
+     * @param id
+     * @return string_view of the token, valid as long as the interner.
+     */
+    string_view token(int id) const {
+        return tokens[id];
+    }
+
+    /**
+     * @brief Number of different tokens.
+     *
+     * @return int
+     */
+    int size() const {
+        return tokens.size();
+    }
+
+    /**
+     * @brief Remove all tokens but keep the allocated memory for reuse.
+     */
+    void clear() {
+        tokens.clear();
+        hashes.clear();
+        fill(table.begin(), table.end(), -1);
+        current_block = 0;
+        block_used = 0;
+    }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 1 << 16;
+    vector<unique_ptr<char[]>> blocks;
+    vector<size_t> block_sizes;
+    size_t current_block = 0;
+    size_t block_used = 0;
+    vector<string_view> tokens;
+    vector<uint32_t> hashes;
+    vector<int> table;
+
+    /**
+     * @brief FNV-1a hash of a token.
+     */
+    static uint32_t hash_token(string_view token) {
+        uint32_t hash = 2166136261u;
+        for(char c : token) {
+            hash = (hash ^ (unsigned char) c) * 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Copy a token into the arena.
+     *
+     * @param token
+     * @return string_view of the copy.
+     */
+    string_view store(string_view token) {
+        while(current_block < blocks.size() && block_used + token.size() > block_sizes[current_block]) {
+            current_block++;
+            block_used = 0;
+        }
+        if(current_block == blocks.size()) {
+            size_t size = max(BLOCK_SIZE, token.size());
+            blocks.emplace_back(new char[size]);
+            block_sizes.push_back(size);
+            block_used = 0;
+        }
+        char* text = blocks[current_block].get() + block_used;
+        memcpy(text, token.data(), token.size());
+        block_used += token.size();
+        return string_view(text, token.size());
+    }
+
+    /**
+     * @brief Double the hash table and reinsert all ids.
+     */
+    void grow() {
+        table = vector<int>(table.size() * 2, -1);
+        size_t mask = table.size() - 1;
+        for(int id = 0; id < (int) tokens.size(); id++) {
+            size_t slot = hashes[id] & mask;
+            while(table[slot] != -1) {
+                slot = (slot + 1) & mask;
+            }
+            table[slot] = id;
+        }
+    }
+};
+
 /**
  * @brief Formats a string vector to a string diving words with a space.
  *
  * @param str_vec
  * @return string
  */
-string output_string(vector<string> str_vec) {
+string output_string(const vector<string_view>& str_vec) {
     string str;
-    for(auto elem : str_vec) {
-            str += elem + " ";
+    for(string_view elem : str_vec) {
+            str += elem;
+            str += ' ';
     }
     str.pop_back();
     return str;
 }
 
 /**
- * @brief Return the current state of the given pair string.
- *
- * @param first
- * @param second
- * @return Swap_case
+ * @brief Union-find over interned words and placeholders where concrete words are always the root
+ * of their union, so the word a placeholder stands for is found with one find_root.
+ * Placeholders of the first and second row are different tokens even if they have the same name.
  */
-Swap_case check_pair(string first, string second) {
-    bool first_is_placeholder = first[0] == '<';
-    bool second_is_placeholder = second[0] == '<';
-
-    if(first_is_placeholder && second_is_placeholder){
-        return do_nothing;
-    } else if(first_is_placeholder && !second_is_placeholder) {
-        return swap_first;
-    } else if(!first_is_placeholder && second_is_placeholder) {
-        return swap_second;
-    } else if(first != second) {
-        return not_same;
-    }
-
-    // case where first and second are same
-    return do_nothing;
-}
+class Unifier {
+public:
+    /**
+     * @brief Get the id of a token, adding it if it has not been seen before.
+     * 
+     * @param token Word or placeholder.
+     * @param row Row the token is in (0 or 1), only used for placeholders.
+     * @return int id of the token.
+     */
+    int intern(string_view token, int row) {
+        bool is_placeholder = token[0] == '<';
+        int kind = is_placeholder ? row + 1 : 0;
+        int token_id = interners[kind].intern(token);
+        if(token_id < (int) nodes[kind].size()) {
+            return nodes[kind][token_id];
+        }
+        // First time the token is seen, give it a node of its own
+        int id = parents.size();
+        nodes[kind].push_back(id);
+        parents.push_back(id);
+        union_sizes.push_back(1);
+        // Only words need their text when printing
+        words.push_back(is_placeholder ? string_view() : interners[kind].token(token_id));
+        return id;
+    }
+
+    /**
+     * @brief Find root node for a token, compressing the path on the way.
+     * 
+     * @param a Id of the token.
+     * @return int of root node for a.
+     */
+    int find_root(int a) {
+        int root = a;
+        while(parents[root] != root) {
+            root = parents[root];
+        }
+        while(parents[a] != root) {
+            int next = parents[a];
+            parents[a] = root;
+            a = next;
+        }
+        return root;
+    }
+
+    /**
+     * @brief Merge the unions of a and b, a concrete word stays root of the merged union.
+     * 
+     * @param a 
+     * @param b 
+     * @return true if they could be merged,
+     * @return false if both unions already are two different words.
+     */
+    bool merge_unions(int a, int b) {
+        int root_a = find_root(a);
+        int root_b = find_root(b);
+        if(root_a == root_b) {
+            return true;
+        }
+        bool word_a = !words[root_a].empty();
+        bool word_b = !words[root_b].empty();
+        if(word_a && word_b) {
+            return false;
+        }
+        // Word first, otherwise merge smaller union into larger one
+        if(word_b || (!word_a && union_sizes[root_a] < union_sizes[root_b])) {
+            swap(root_a, root_b);
+        }
+        parents[root_b] = root_a;
+        union_sizes[root_a] += union_sizes[root_b];
+        return true;
+    }
+
+    /**
+     * @brief Get the word the token is unified with.
+     * 
+     * @param a Id of the token.
+     * @return string_view of the word, empty if it is only unified with placeholders.
+     */
+    string_view word(int a) {
+        return words[find_root(a)];
+    }
+
+private:
+    // Words, placeholders of the first row and placeholders of the second row
+    Interner interners[3];
+    // Union-find node of every interned token, per interner
+    vector<int> nodes[3];
+    vector<int> parents;
+    vector<int> union_sizes;
+    // Text of word tokens, empty for placeholders
+    vector<string_view> words;
+};
 
 /**
- * @brief Goes through both lists and changes/ swaps the the placeholders if possible.
+ * @brief Unify both rows pair by pair and print the first row with every placeholder replaced by its word.
+ * Has time complexity O(N a(N)) where N is the number of words in a row.
  *
  * @param first_row
  * @param second_row
- * @return string
+ * @return string of the unified row, "-" if the rows cannot be unified.
  */
-string check_whole_lists(vector<string> first_row, vector<string> second_row) {
-    int i = 0;
-    while(i < first_row.size()) {
-        string first = first_row[i];
-        string second = second_row[i];
-        i++;
-        Swap_case case_number = check_pair(first, second);
-
-        switch(case_number)
-        {
-            case do_nothing:
-                // Both paceholders or same words, go to next pair.
-                continue;
-                break;
-
-            case swap_first:
-                for(int k = 0; k < first_row.size(); k++){
-                    if(first_row[k] == first){
-                        first_row[k] = second;
-                    }
-                }
-                // Reset to check all pairs from beginning.
-                i = 0;
-                break;
-
-            case swap_second:
-                for(int k = 0; k < second_row.size(); k++){
-                    if(second_row[k] == second){
-                        second_row[k] = first;
-                    }
-                }
-                // Reset to check all pairs from beginning.
-                i = 0;
-                break;
-
-            case not_same:
-                return "-";
-                break;
-
-            default:
-                return "-";
-                break;
-
-        }
-    }
-    // replace placeholders with random word (placeholder).
-    for(int i = 0; i < first_row.size(); i++) {
-        if(first_row[i][0] == '<'){
-            first_row[i] = "placeholder";
-        }
-    }
-    return output_string(first_row);
+string check_whole_lists(const vector<string_view>& first_row, const vector<string_view>& second_row) {
+    Unifier unifier;
+    vector<int> first_ids(first_row.size());
+    for(int i = 0; i < (int) first_row.size(); i++) {
+        first_ids[i] = unifier.intern(first_row[i], 0);
+        int second_id = unifier.intern(second_row[i], 1);
+        if(!unifier.merge_unions(first_ids[i], second_id)) {
+            return "-";
+        }
+    }
 
+    // replace placeholders with their word or a random word (placeholder).
+    vector<string_view> output_row(first_row.size());
+    for(int i = 0; i < (int) first_row.size(); i++) {
+        string_view word = unifier.word(first_ids[i]);
+        output_row[i] = word.empty() ? "placeholder" : word;
+    }
+    return output_string(output_row);
 }
 
 /**
@@ -128,18 +336,14 @@ string check_whole_lists(vector<string> first_row, vector<string> second_row) {
 int main() {
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
-    string input;
-    getline(cin, input);
-    int testcases = stoi(input);
+    string input = read_input();
+    string_view buffer = input;
+    int testcases = stoi(string(next_line(buffer)));
 
     for(int i = 0; i < testcases; i++) {
-        // Divide first and second rows into vectors of strings (words).
-        vector<string> first_row;
-        vector<string> second_row;
-        getline(cin, input);
-        first_row = separate_string(input);
-        getline(cin, input);
-        second_row = separate_string(input);
+        // Divide first and second rows into views of the words.
+        vector<string_view> first_row = tokenize(next_line(buffer));
+        vector<string_view> second_row = tokenize(next_line(buffer));
         // Checks for easy cases. Not the same length and no length.
         if(first_row.size() != second_row.size()) {
             cout << "-" << "\n";
@@ -5,6 +5,7 @@
 #include <numeric>
 #include <cmath>
 #include <string>
+#include <limits>
 using namespace std;
 
 struct Bridge_position {
@@ -85,11 +86,236 @@ double euclidean_dist(double x1, double x2, double y1, double y2) {
     return sqrt(pow(abs(x1-x2), 2) + pow(abs(y1-y2), 2));
 }
 
-int main(){
+double squared_dist(const Bridge_position& a, const Bridge_position& b) {
+    double dx = a.x_pos - b.x_pos;
+    double dy = a.y_pos - b.y_pos;
+    return dx * dx + dy * dy;
+}
+
+/**
+ * @brief Possible bridge between two islands, from < to. Bridges are ordered by squared length and then by
+ * the islands, so no two bridges are equal (needed for Boruvka to not make cycles).
+ */
+struct Bridge {
+    double dist;
+    int from, to;
+
+    bool operator<(const Bridge& other) const {
+        if(dist != other.dist) {
+            return dist < other.dist;
+        }
+        return from != other.from ? from < other.from : to < other.to;
+    }
+};
+
+/**
+ * @brief K-d tree over the islands. The islands are kept in one array, the island in the middle of a range
+ * splits it on the axis where the range is widest, lower half before it and upper half after it.
+ */
+class KdTree {
+public:
+    /**
+     * @brief Build the tree in O(NlogN).
+     * 
+     * @param positions Positions of the islands, has to outlive the tree.
+     */
+    KdTree(const vector<Bridge_position>& positions) : positions(positions), order(positions.size()),
+        split_x(positions.size()), roots(positions.size()), range_roots(positions.size()) {
+        iota(order.begin(), order.end(), 0);
+        build(0, order.size());
+    }
+
+    /**
+     * @brief All islands within distance radius of a position.
+     * 
+     * @param center
+     * @param radius
+     * @return vector<int> of the islands, in increasing order.
+     */
+    vector<int> within(const Bridge_position& center, double radius) const {
+        vector<int> found;
+        within(0, order.size(), center, radius * radius, found);
+        sort(found.begin(), found.end());
+        return found;
+    }
+
+    /**
+     * @brief Save what union every island is in, used by nearest_outside. O(N).
+     * 
+     * @param parents Vector of all parents for each element in the collection of (disjoint) sets.
+     */
+    void set_unions(vector<int>& parents) {
+        for(size_t island = 0; island < roots.size(); island++) {
+            roots[island] = find_root(parents, island);
+        }
+        set_range_roots(0, order.size());
+    }
+
+    /**
+     * @brief Find the shortest bridge from island to an island in another union, if it is shorter than best.
+     * Ranges where all islands are in the union of island are skipped.
+     * 
+     * @param island
+     * @param best Shortest bridge so far, updated.
+     */
+    void nearest_outside(int island, Bridge& best) const {
+        nearest_outside(0, order.size(), island, best);
+    }
+
+private:
+    const vector<Bridge_position>& positions;
+    // Islands in tree order, and for every middle island what axis its range is split on
+    vector<int> order;
+    vector<bool> split_x;
+    // Union of every island, and of every range (by its middle) with -1 when it has islands from more unions
+    vector<int> roots;
+    vector<int> range_roots;
+
+    double coordinate(int island, bool x) const {
+        return x ? positions[island].x_pos : positions[island].y_pos;
+    }
+
+    void build(int begin, int end) {
+        if(end - begin <= 1) {
+            return;
+        }
+        double min_x = positions[order[begin]].x_pos, max_x = min_x;
+        double min_y = positions[order[begin]].y_pos, max_y = min_y;
+        for(int i = begin; i < end; i++) {
+            min_x = min(min_x, positions[order[i]].x_pos);
+            max_x = max(max_x, positions[order[i]].x_pos);
+            min_y = min(min_y, positions[order[i]].y_pos);
+            max_y = max(max_y, positions[order[i]].y_pos);
+        }
+        int mid = (begin + end) / 2;
+        bool x = max_x - min_x >= max_y - min_y;
+        split_x[mid] = x;
+        nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, [this, x](int a, int b) {
+            return coordinate(a, x) < coordinate(b, x);
+        });
+        build(begin, mid);
+        build(mid + 1, end);
+    }
+
+    void within(int begin, int end, const Bridge_position& center, double squared_radius, vector<int>& found) const {
+        if(begin >= end) {
+            return;
+        }
+        int mid = (begin + end) / 2;
+        int island = order[mid];
+        if(squared_dist(positions[island], center) <= squared_radius) {
+            found.push_back(island);
+        }
+        double diff = (split_x[mid] ? center.x_pos : center.y_pos) - coordinate(island, split_x[mid]);
+        if(diff <= 0 || diff * diff <= squared_radius) {
+            within(begin, mid, center, squared_radius, found);
+        }
+        if(diff >= 0 || diff * diff <= squared_radius) {
+            within(mid + 1, end, center, squared_radius, found);
+        }
+    }
+
+    /**
+     * @return int union of all islands in the range, -1 if more than one, -2 if the range is empty.
+     */
+    int set_range_roots(int begin, int end) {
+        if(begin >= end) {
+            return -2;
+        }
+        int mid = (begin + end) / 2;
+        int root = roots[order[mid]];
+        int lower = set_range_roots(begin, mid);
+        int upper = set_range_roots(mid + 1, end);
+        if((lower != -2 && lower != root) || (upper != -2 && upper != root)) {
+            root = -1;
+        }
+        range_roots[mid] = root;
+        return root;
+    }
+
+    void nearest_outside(int begin, int end, int island, Bridge& best) const {
+        if(begin >= end) {
+            return;
+        }
+        int mid = (begin + end) / 2;
+        if(range_roots[mid] == roots[island]) {
+            return;
+        }
+        int other = order[mid];
+        if(roots[other] != roots[island]) {
+            Bridge bridge{squared_dist(positions[island], positions[other]), min(island, other), max(island, other)};
+            if(bridge < best) {
+                best = bridge;
+            }
+        }
+
+        // Closest side first, the other side only if it can have a bridge as short
+        double diff = coordinate(island, split_x[mid]) - coordinate(other, split_x[mid]);
+        if(diff <= 0) {
+            nearest_outside(begin, mid, island, best);
+            if(diff * diff <= best.dist) {
+                nearest_outside(mid + 1, end, island, best);
+            }
+        } else {
+            nearest_outside(mid + 1, end, island, best);
+            if(diff * diff <= best.dist) {
+                nearest_outside(begin, mid, island, best);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Find the bridges of the minimal spanning tree with Boruvka's algorithm. Every round each union
+ * gets its shortest bridge to another union from the k-d tree, and all of them are added. The number of
+ * unions at least halves every round, so it takes O(log(N)) rounds of around O(NlogN).
+ * 
+ * @param positions Positions of the islands.
+ * @return vector<pair<int, int>> of the islands connected by the bridges.
+ */
+vector<pair<int, int>> boruvka_bridges(const vector<Bridge_position>& positions) {
+    int islands = positions.size();
+    vector<int> parents(islands);
+    std::iota(parents.begin(), parents.end(), 0);
+    vector<int> union_sizes(islands, 1);
+    KdTree tree(positions);
+
+    vector<pair<int, int>> bridges;
+    const Bridge no_bridge{numeric_limits<double>::infinity(), islands, islands};
+    vector<Bridge> shortest(islands);
+    while((int) bridges.size() < islands - 1) {
+        tree.set_unions(parents);
+        fill(shortest.begin(), shortest.end(), no_bridge);
+        // Islands of the same union share the shortest bridge, so later islands can skip more
+        for(int island = 0; island < islands; island++) {
+            tree.nearest_outside(island, shortest[find_root(parents, island)]);
+        }
+        for(int root = 0; root < islands; root++) {
+            const Bridge& bridge = shortest[root];
+            if(bridge.from != islands && !find(parents, bridge.from, bridge.to)) {
+                merge_unions(parents, union_sizes, bridge.from, bridge.to);
+                bridges.push_back({bridge.from, bridge.to});
+            }
+        }
+    }
+    return bridges;
+}
+
+/**
+ * @brief Total length of the minimal spanning tree of bridges. With "pairs" as argument every bridge is
+ * tried in order of length (Kruskal), otherwise the tree comes from boruvka_bridges. The lengths are added
+ * shortest first either way so the sums are the same. With "radius" as argument each case is followed by
+ * a number of queries x y r, answered with the islands within distance r of (x, y).
+ * 
+ * @return int
+ */
+int main(int argc, char* argv[]){
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
     cout.tie(NULL);
 
+    string mode = argc > 1 ? argv[1] : "";
+
     int num_cases;
     cin >> num_cases;
     for(int num_case = 0; num_case < num_cases; num_case++) {
@@ -104,6 +330,40 @@ int main(){
             double y_pos = stod(y_pos_s);
             bridge_positions[island] = Bridge_position{x_pos, y_pos};
         }
+
+        if(mode == "radius") {
+            KdTree tree(bridge_positions);
+            int queries;
+            cin >> queries;
+            for(int query = 0; query < queries; query++) {
+                double x_pos, y_pos, radius;
+                cin >> x_pos >> y_pos >> radius;
+                vector<int> found = tree.within(Bridge_position{x_pos, y_pos}, radius);
+                cout << found.size();
+                for(int island : found) {
+                    cout << " " << island;
+                }
+                cout << "\n";
+            }
+            continue;
+        }
+
+        if(mode != "pairs") {
+            vector<double> costs;
+            for(pair<int, int> bridge : boruvka_bridges(bridge_positions)) {
+                Bridge_position island1 = bridge_positions[bridge.first];
+                Bridge_position island2 = bridge_positions[bridge.second];
+                costs.push_back(euclidean_dist(island1.x_pos, island2.x_pos, island1.y_pos, island2.y_pos));
+            }
+            sort(costs.begin(), costs.end());
+            double total_path_cost = 0;
+            for(double cost : costs) {
+                total_path_cost += cost;
+            }
+            cout << total_path_cost << endl;
+            continue;
+        }
+
         vector<int> parents(islands);
         std::iota(parents.begin(), parents.end(), 0);
         vector<int> union_sizes(islands, 1);
@@ -136,4 +396,4 @@ int main(){
         }
         cout << total_path_cost << endl;
     }
-}
\ No newline at end of file
+}
@@ -1,7 +1,7 @@
 /**
  * @file interval_covers.cpp
  * @author Daniel Purgal, danpu323 (danpu323@student.liu.se)
- * @brief Find what given intervals are needed to cover a given interval, in O(NlogN) complexity. 
+ * @brief Find what given intervals are needed to cover a given interval, in O(N) complexity using a radix sort. 
  *  Printing "impossible" if it cannot be done.
  * @version 0.1
  * @date 2024-02-06
@@ -11,120 +11,297 @@
 // Includes
 #include <vector>
 #include <iostream>
-#include <tuple>
 #include <algorithm>
-#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <string>
 using namespace std;
 
 /**
- * @brief Compares two tuples to find who has larger first value.
- * 
- * @param i1 Tuple of type double, double,  int 
- * @param i2 Tuple of type double, double,  int
- * @return true if i1 has larger first value.
- * @return false otherwise
+ * @brief Intervals stored as separate arrays of starts, ends and ids (struct of arrays). The buffers are
+ * kept between test cases with clear, so only the first test cases allocate memory.
  */
-bool interval_compare(tuple<double, double, int>& i1, tuple<double, double, int>& i2) {
-    return (get<0>(i1) < get<0>(i2));
-}
+class IntervalCover {
+public:
+    /**
+     * @brief Remove all intervals but keep the buffers.
+     */
+    void clear() {
+        starts.clear();
+        ends.clear();
+        ids.clear();
+    }
 
-/**
- * @brief A greedy approch to find minimal amount of intervals to cover a given interval.
- * 
- * @param interval tuple of double, double, int - interval to be check.
- * @param intervals vector of intervals of type tuple: double, double, int.
- * @return vector<int> of which indexes of original intervals vector that are needed to cover interval. 
- *  First value -1 if impossible. 
- */
-vector<int> count_intervals(tuple<double, double> interval, vector<tuple<double, double, int>> intervals) {
-    // Initiate variables
-    double primary_start = get<0>(interval);
-    double primary_end = get<1>(interval);
-    double start = primary_start;
-    double end = start - 1;
+    /**
+     * @brief Add an interval.
+     * 
+     * @param start 
+     * @param end 
+     * @param id Index printed when the interval is used.
+     */
+    void add(double start, double end, int id) {
+        starts.push_back(start);
+        ends.push_back(end);
+        ids.push_back(id);
+    }
+
+    /**
+     * @brief A greedy approch to find minimal amount of intervals to cover a given interval. The intervals
+     * are gone through in order of start, every time the next one starts after the covered part the
+     * interval reaching furthest so far is used. O(N) after the radix sort.
+     * 
+     * @param primary_start Start of interval to be covered.
+     * @param primary_end End of interval to be covered.
+     * @return const vector<int>& of which ids that are needed to cover interval. First value -1 if impossible.
+     */
+    const vector<int>& count_intervals(double primary_start, double primary_end) {
+        sort_on_start();
+        double start = primary_start;
+        double end = start - 1;
+        indexes.clear();
+
+        int index = -1;
+        size_t i = 0;
+        // Main loop checking all intervals.
+        while(true) {
+            if(i < order.size() && starts[order[i]] <= start) {
+                // Only update if new end is better (higher)
+                if(ends[order[i]] > end) {
+                    end = ends[order[i]];
+                    index = ids[order[i]];
+                }
+                i++;
+            } else {
+                // Current interval doesn't cover the start, need a new interval
+                start = end;
+                if (index != -1) { indexes.push_back(index);}
+                // End of loop, impossible or done
+                if (i == order.size() || starts[order[i]] > end || end >= primary_end) {
+                    break;
+                }
+            }
+        }
+
+        if (end < primary_end) {
+            // Can't find valid intervals to cover interval.
+            indexes.assign(1, -1);
+        }
+        return indexes;
+    }
+
+    /**
+     * @brief Prepare the intervals for many cover queries with binary lifting. From the interval at sorted
+     * position p the greedy goes on with the interval reaching furthest among those starting at or before
+     * the end of p, jumps[k][p] is where it is after 2^k such steps. A step that does not reach further
+     * stays on the same interval. O(NlogN) time and memory.
+     */
+    void build_jumps() {
+        sort_on_start();
+        int size = order.size();
+        sorted_starts.resize(size);
+        sorted_ends.resize(size);
+        furthest.resize(size);
+        for(int i = 0; i < size; i++) {
+            sorted_starts[i] = starts[order[i]];
+            sorted_ends[i] = ends[order[i]];
+            // First interval with the highest end so far, the same one the greedy keeps
+            furthest[i] = (i > 0 && sorted_ends[furthest[i - 1]] >= sorted_ends[i]) ? furthest[i - 1] : i;
+        }
+
+        levels = 1;
+        while((1 << levels) < size) {
+            levels++;
+        }
+        jumps.resize((size_t) levels * size);
+        for(int i = 0; i < size; i++) {
+            int next = furthest_from(sorted_ends[i]);
+            jumps[i] = (next != -1 && sorted_ends[next] > sorted_ends[i]) ? next : i;
+        }
+        for(int level = 1; level < levels; level++) {
+            const int* previous = jumps.data() + (size_t) (level - 1) * size;
+            int* current = jumps.data() + (size_t) level * size;
+            for(int i = 0; i < size; i++) {
+                current[i] = previous[previous[i]];
+            }
+        }
+    }
+
+    /**
+     * @brief Same result as count_intervals but with the table from build_jumps, so the intervals are not
+     * gone through again. The number of intervals is found in O(logN), listing them takes one step each.
+     * 
+     * @param primary_start Start of interval to be covered.
+     * @param primary_end End of interval to be covered.
+     * @return const vector<int>& of which ids that are needed to cover interval. First value -1 if impossible.
+     */
+    const vector<int>& cover(double primary_start, double primary_end) {
+        int size = sorted_starts.size();
+        indexes.clear();
+        int first = furthest_from(primary_start);
+        // Nothing reaches the start, the greedy then has end = start - 1
+        if(first == -1 || sorted_ends[first] <= primary_start - 1) {
+            if(primary_start - 1 < primary_end) {
+                indexes.assign(1, -1);
+            }
+            return indexes;
+        }
+
+        // Take the largest number of steps that still ends before primary_end
+        int current = first;
+        int steps = 1;
+        for(int level = levels - 1; level >= 0; level--) {
+            int next = jumps[(size_t) level * size + current];
+            if(sorted_ends[next] < primary_end) {
+                current = next;
+                steps += 1 << level;
+            }
+        }
+        if(sorted_ends[current] < primary_end) {
+            current = jumps[current];
+            steps++;
+            if(sorted_ends[current] < primary_end) {
+                indexes.assign(1, -1);
+                return indexes;
+            }
+        }
+
+        current = first;
+        for(int step = 0; step < steps; step++) {
+            indexes.push_back(ids[order[current]]);
+            current = jumps[current];
+        }
+        return indexes;
+    }
+
+private:
+    vector<double> starts;
+    vector<double> ends;
+    vector<int> ids;
+    // Positions of the intervals in order of start, and buffers for the radix sort
+    vector<int> order;
+    vector<int> order_buffer;
+    vector<uint64_t> keys;
+    vector<uint64_t> key_buffer;
     vector<int> indexes;
+    // Sorted intervals and the jump table from build_jumps
+    vector<double> sorted_starts;
+    vector<double> sorted_ends;
+    vector<int> furthest;
+    vector<int> jumps;
+    int levels = 0;
 
-    // Sort interval with complexity O(NlogN) on start value (of tuple).
-    sort(intervals.begin(), intervals.end(), interval_compare);
-
-    // Padding to not go outside boundaries.
-    intervals.push_back(make_tuple(DBL_MAX, DBL_MAX, -1));
-    
-    int index = -1;
-    // Main loop checking all intervals.
-    for (unsigned i = 0; i < intervals.size();) {
-        tuple<double, double, int> new_interval = intervals[i];
-        double new_start = get<0>(new_interval);
-        double new_end = get<1>(new_interval);
-
-        // Update end, is it a better interval or worse?
-        if (new_start <= start) {
-            // Only update if new end is better (higher)
-            if (new_end > end) {
-                end = new_end;
-                index = get<2>(new_interval);
+    /**
+     * @brief Sorted position of the interval reaching furthest among those starting at or before point.
+     * 
+     * @param point 
+     * @return int position, -1 if no interval starts at or before point.
+     */
+    int furthest_from(double point) const {
+        int count = upper_bound(sorted_starts.begin(), sorted_starts.end(), point) - sorted_starts.begin();
+        return count == 0 ? -1 : furthest[count - 1];
+    }
+
+    /**
+     * @brief Sort the positions on start with a LSD radix sort, 8 bits at a time, in O(N). The doubles are
+     * turned into integers with the same order: negative numbers get all bits flipped, positive numbers
+     * only the sign bit. Passes where all keys have the same byte are skipped. The sort is stable, so
+     * intervals with the same start keep their input order.
+     */
+    void sort_on_start() {
+        size_t size = starts.size();
+        keys.resize(size);
+        key_buffer.resize(size);
+        order.resize(size);
+        order_buffer.resize(size);
+        for(size_t i = 0; i < size; i++) {
+            uint64_t bits;
+            memcpy(&bits, &starts[i], sizeof(bits));
+            keys[i] = (bits >> 63) ? ~bits : bits | ((uint64_t) 1 << 63);
+            order[i] = i;
+        }
+        for(int shift = 0; shift < 64; shift += 8) {
+            size_t counts[257] = {0};
+            for(size_t i = 0; i < size; i++) {
+                counts[((keys[i] >> shift) & 0xff) + 1]++;
+            }
+            if(size == 0 || counts[((keys[0] >> shift) & 0xff) + 1] == size) {
+                continue;
             }
-            i++;
-        } else {
-            // Current interval doesn't cover the start, need a new interval
-            start = end;
-
-            if (index != -1) { indexes.push_back(index);}
-            // End of loop, impossible or done
-            if (new_start > end || end >= primary_end) {
-                break;
+            for(int digit = 0; digit < 256; digit++) {
+                counts[digit + 1] += counts[digit];
             }
+            for(size_t i = 0; i < size; i++) {
+                size_t to = counts[(keys[i] >> shift) & 0xff]++;
+                key_buffer[to] = keys[i];
+                order_buffer[to] = order[i];
+            }
+            keys.swap(key_buffer);
+            order.swap(order_buffer);
         }
     }
+};
 
-    // Returns
-    if (end < primary_end) {
-        // Can't find valid intervals to cover interval.
-        vector<int> invalid = {-1};
-        return invalid;
+/**
+ * @brief Print the number of intervals and their ids, or impossible.
+ * 
+ * @param interval_count Result of count_intervals or cover.
+ */
+void print_cover(const vector<int>& interval_count) {
+    if (interval_count.size() != 0 && interval_count.front() == -1) {
+        cout << "impossible\n";
+    } else {
+        cout << interval_count.size() << "\n";
+        for(int count : interval_count) {
+            cout << count << " ";
+        }
+        cout << "\n";
     }
-    
-    return indexes;
 }
 
 /**
- * @brief Executes algorithm.
+ * @brief Executes algorithm. With "queries" as argument the input is instead the number of intervals,
+ *  the intervals, and then any number of intervals to be covered, all answered with the jump table.
  * 
  * @return int 
  */
-int main(){
+int main(int argc, char* argv[]){
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
     cout.tie(NULL);
 
+    IntervalCover intervals;
     // Get interval to be checked
     double start_interval;
     double end_interval;
+    if(argc > 1 && string(argv[1]) == "queries") {
+        int num_intervals = 0;
+        cin >> num_intervals;
+        for (int i = 0; i < num_intervals; i++) {
+            cin >> start_interval >> end_interval;
+            intervals.add(start_interval, end_interval, i);
+        }
+        intervals.build_jumps();
+        while(cin >> start_interval >> end_interval) {
+            print_cover(intervals.cover(start_interval, end_interval));
+        }
+        return 0;
+    }
+
     while(cin >> start_interval >> end_interval) {
-        tuple<double, double> interval = make_tuple(start_interval, end_interval);
+        double primary_start = start_interval;
+        double primary_end = end_interval;
         // Number of intervals that will be given. 
         int num_intervals;
         cin >> num_intervals;
 
-        // Create intervals vector
-        vector<tuple<double, double, int>> intervals;
+        // Fill the intervals, reusing the buffers of the last test case
+        intervals.clear();
         for (int i = 0; i < num_intervals; i++) {
             cin >> start_interval >> end_interval;
-            intervals.push_back(make_tuple(start_interval, end_interval, i));
+            intervals.add(start_interval, end_interval, i);
         }
 
-        // Find number of counts
-        vector<int> interval_count = count_intervals(interval, intervals);
-
-        // Print results
-        if (interval_count.size() != 0 && interval_count.front() == -1) {
-            cout << "impossible\n";
-        } else {
-            cout << interval_count.size() << "\n";
-            for(int count : interval_count) {
-                cout << count << " ";
-            }
-            cout << "\n";
-        }
+        // Find number of counts and print results
+        print_cover(intervals.count_intervals(primary_start, primary_end));
     }
-}
\ No newline at end of file
+}
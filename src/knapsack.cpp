@@ -10,14 +10,31 @@
  * in the sack?
  * 
  * Solves with time complexity O(N*Capacity) because of nested loops, one of length N
- * and a nested of length capacity. Memory usage of O(N*Capacity) where N is 
- * the number of given items and capacity is max weight limit of sack. The large memory
- * usage is because a grid like structure is made with N+1 rows and Capacity+1 columns.
+ * and a nested of length capacity. Where N is the number of given items and capacity is
+ * max weight limit of sack. Only two rows of values (O(Capacity)) are kept, the choices
+ * needed for back tracking are stored as one bit per item and capacity, N*Capacity/8 bytes.
+ * The capacities of a row can be filled by several threads.
+ *
+ * Other variants are chosen with a program argument, the thread count is given as a number:
+ *   bounded   -> every item line also has a count of how many there are (value weight count).
+ *   unbounded -> every item can be used any number of times.
+ *   mitm      -> 0/1 with meet in the middle, for at most 40 items and capacities too large for rows.
+ * An item used several times is printed once for every use.
  */
 
 // Includes
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <string>
+#include <cctype>
+#include <climits>
 using namespace std;
 
 /**
@@ -28,40 +45,139 @@ struct Item
     int weight, value, index;
 };
 
+/**
+ * @brief Makes threads wait for each other, used to keep all threads on the same item row.
+ */
+class Barrier {
+public:
+    /**
+     * @brief Construct a new Barrier object
+     * 
+     * @param num_threads Number of threads that has to arrive before any may continue.
+     */
+    Barrier(int num_threads) : num_threads(num_threads) {}
+
+    /**
+     * @brief Wait until all threads have arrived.
+     */
+    void arrive_and_wait() {
+        unique_lock<mutex> lock(barrier_mutex);
+        int arrived_generation = generation;
+        arrived++;
+        if(arrived == num_threads) {
+            // Last thread releases the others and starts a new generation
+            arrived = 0;
+            generation++;
+            released.notify_all();
+        } else {
+            released.wait(lock, [&] { return generation != arrived_generation; });
+        }
+    }
+
+private:
+    mutex barrier_mutex;
+    condition_variable released;
+    int num_threads;
+    int arrived = 0;
+    int generation = 0;
+};
+
+/**
+ * @brief Fill all item rows for the capacities in words [word_begin, word_end) of the bitmap, so a
+ * thread only writes whole words of its own. Row i + 1 is read from rows[i % 2] and written to
+ * rows[(i + 1) % 2], the barrier keeps a thread from reading a row before all its parts are written.
+ * 
+ * @param items Vector of given items.
+ * @param capacity Max capacity of the sack.
+ * @param word_begin First bitmap word (capacity / 64) to fill.
+ * @param word_end Bitmap word after the last to fill.
+ * @param rows Two rows of values with capacity + 1 elements.
+ * @param taken Decision bitmap, row_words words per item.
+ * @param take One byte per capacity used before the decisions are packed.
+ * @param barrier Barrier shared by all threads, nullptr when running alone.
+ */
+void fill_rows(const vector<Item>& items, int capacity, size_t word_begin, size_t word_end,
+               vector<int>* rows, vector<uint64_t>& taken, vector<uint8_t>& take, Barrier* barrier) {
+    size_t row_words = (capacity + 1 + 63) / 64;
+    int begin = word_begin * 64;
+    int end = min((size_t) capacity + 1, word_end * 64);
+
+    for(int i = 0; i < (int) items.size(); i++) {
+        const Item& item = items[i];
+        int item_value = item.value;
+        int item_weight = item.weight;
+        // Capacity 0 is never filled, same as the full grid
+        int start = min(max(max(item_weight, 1), begin), end);
+
+        const int* prev = rows[i % 2].data();
+        int* curr = rows[(i + 1) % 2].data();
+        uint8_t* take_pos = take.data();
+        // Capacities below the weight keep the previous value and do not take the item
+        copy(prev + begin, prev + start, curr + begin);
+        fill(take_pos + begin, take_pos + start, 0);
+        // No dependency between capacities in a row so this loop vectorizes
+        for(int curr_capacity = start; curr_capacity < end; curr_capacity++) {
+            int value_of_pos = prev[curr_capacity];
+            int prev_side_value = prev[curr_capacity - item_weight] + item_value;
+            bool is_better = prev_side_value > value_of_pos;
+            curr[curr_capacity] = is_better ? prev_side_value : value_of_pos;
+            take_pos[curr_capacity] = is_better;
+        }
+
+        // Pack the decisions into bits
+        uint64_t* bits = &taken[i * row_words];
+        for(size_t word = word_begin; word < word_end; word++) {
+            uint64_t packed = 0;
+            size_t word_size = min((size_t) capacity + 1 - word * 64, (size_t) 64);
+            for(size_t b = 0; b < word_size; b++) {
+                packed |= (uint64_t) take_pos[word * 64 + b] << b;
+            }
+            bits[word] = packed;
+        }
+        if(barrier != nullptr) {
+            barrier->arrive_and_wait();
+        }
+    }
+}
+
 /**
  * @brief Using a dysnamic algorithm, solves the napsack problem to give what items are needed to
- * have highest value still within the given capacity.
+ * have highest value still within the given capacity. Only the previous and current row of values
+ * are kept, together with one bit per item and capacity telling if the item was taken there.
+ * Every row only depends on the previous row, so the capacities are split in ranges over num_threads
+ * threads that meet at a barrier after each item.
  * 
  * @param items Vector of given items.
  * @param capacity Max capacity of the sack.
+ * @param num_threads Number of threads to fill the rows with.
  * @return vector<int> of indexes of which items are used to solve the napsack problem and give
  * highest value in the sack.
  */
-vector<int> knapsack(vector<Item> items, int capacity) {
+vector<int> knapsack(const vector<Item>& items, int capacity, int num_threads = 1) {
     int num_items = items.size();
+    // Bits needed for one row, rounded up to whole words
+    size_t row_words = (capacity + 1 + 63) / 64;
 
-    vector<vector<int>> grid(num_items+1, vector<int>(capacity+1, 0));
-    
-    // Fill the grid (the sack with all cases)
-    for(auto item : items) {
-        for(int curr_capacity = 1; curr_capacity <= capacity; curr_capacity++) {
-            // Initialize useful variables
-            int item_index = item.index;
-            int item_value = item.value;
-            int item_weight = item.weight;
-            int value_of_pos = grid[item_index-1][curr_capacity]; // default value of prev grid same capacity
-            
-            // Position value should not be 0
-            if(curr_capacity >= item_weight) {
-                // Update with prev grid value on best path
-                int prev_grid_side_value = grid[item_index-1][curr_capacity-item_weight] + item_value;
-                //cout << prev_grid_side_value << " " << prev_grid_value << endl;
-                if(prev_grid_side_value > value_of_pos){
-                    value_of_pos = prev_grid_side_value;
-                }
-            }
-            // Update grid value
-            grid[item_index][curr_capacity] = value_of_pos;
+    vector<int> rows[2] = {vector<int>(capacity + 1, 0), vector<int>(capacity + 1, 0)};
+    // Decision bit of item i at capacity c is bit c % 64 of word i * row_words + c / 64
+    vector<uint64_t> taken(num_items * row_words, 0);
+    vector<uint8_t> take(capacity + 1, 0);
+
+    // Fill the rows (the sack with all cases), no more threads than words in a row
+    num_threads = max(1, min(num_threads, (int) row_words));
+    if(num_threads == 1) {
+        fill_rows(items, capacity, 0, row_words, rows, taken, take, nullptr);
+    } else {
+        Barrier barrier(num_threads);
+        vector<thread> threads;
+        for(int t = 0; t < num_threads; t++) {
+            size_t word_begin = row_words * t / num_threads;
+            size_t word_end = row_words * (t + 1) / num_threads;
+            threads.emplace_back(fill_rows, cref(items), capacity, word_begin, word_end,
+                                 rows, ref(taken), ref(take), &barrier);
+        }
+        for(thread& t : threads) {
+            t.join();
         }
     }
 
@@ -70,21 +186,193 @@ vector<int> knapsack(vector<Item> items, int capacity) {
 
     // Back tracking to find optimal path.
     for(int index = num_items-1; index >= 0; index--) {
-        Item item = items[index];
-        int weight = item.weight;
-
-        int curr_value = grid[index+1][curr_capacity];
-        // Space in sack to add item
-        if(curr_capacity >= weight) {
-            int next_value_straight = grid[index][curr_capacity];
-            // Adding curr item gives more value than not adding
-            if(curr_value > next_value_straight) {
-                curr_capacity -= weight;
-                items_in_sack.push_back(index);
+        uint64_t word = taken[index * row_words + curr_capacity / 64];
+        // Adding curr item gave more value than not adding
+        if((word >> (curr_capacity % 64)) & 1) {
+            curr_capacity -= items[index].weight;
+            items_in_sack.push_back(index);
+        }
+    }
+
+    return items_in_sack;
+}
+
+/**
+ * @brief Solves the bounded napsack problem where item i can be used up to counts[i] times.
+ * Every count is split in pieces 1, 2, 4, ..., rest so that any number up to the count is a sum of
+ * pieces, then the pieces are solved as a 0/1 napsack. Time complexity O(sum(log(count))*Capacity).
+ * 
+ * @param items Vector of given items.
+ * @param counts How many of each item there are.
+ * @param capacity Max capacity of the sack.
+ * @param num_threads Number of threads to fill the rows with.
+ * @return vector<int> of indexes of used items in decreasing order, an item used k times is there k times.
+ */
+vector<int> bounded_knapsack(const vector<Item>& items, const vector<int>& counts, int capacity, int num_threads = 1) {
+    vector<Item> pieces;
+    vector<int> piece_counts;
+    vector<int> items_in_sack;
+    for(int i = 0; i < (int) items.size(); i++) {
+        int left = counts[i];
+        // Items without weight are always worth taking all of
+        if(items[i].weight == 0) {
+            if(items[i].value > 0) {
+                items_in_sack.insert(items_in_sack.end(), left, i);
             }
-        } 
+            continue;
+        }
+        for(int piece = 1; left > 0; piece *= 2) {
+            int used = min(piece, left);
+            left -= used;
+            // Skip pieces that can never fit, they would only make the rows longer
+            if((long) items[i].weight * used > capacity) {
+                break;
+            }
+            // The rows are int, so the value of a piece has to fit too (main checks all values together)
+            long piece_value = (long) items[i].value * used;
+            if(piece_value > INT_MAX || piece_value < INT_MIN) {
+                break;
+            }
+            pieces.push_back(Item{ items[i].weight * used, (int) piece_value, items[i].index });
+            piece_counts.push_back(used);
+        }
     }
 
+    for(int piece : knapsack(pieces, capacity, num_threads)) {
+        for(int k = 0; k < piece_counts[piece]; k++) {
+            items_in_sack.push_back(pieces[piece].index - 1);
+        }
+    }
+    sort(items_in_sack.rbegin(), items_in_sack.rend());
+    return items_in_sack;
+}
+
+/**
+ * @brief Solves the unbounded napsack problem where every item can be used any number of times.
+ * best[c] is the highest value with weight at most c and last[c] the item last added to reach it,
+ * items with weight 0 are skipped since they would make the value unbounded. Time complexity O(N*Capacity).
+ * 
+ * @param items Vector of given items.
+ * @param capacity Max capacity of the sack.
+ * @return vector<int> of indexes of used items in decreasing order, an item used k times is there k times.
+ */
+vector<int> unbounded_knapsack(const vector<Item>& items, int capacity) {
+    vector<long> best(capacity + 1, 0);
+    vector<int> last(capacity + 1, -1);
+    for(int i = 0; i < (int) items.size(); i++) {
+        int item_weight = items[i].weight;
+        long item_value = items[i].value;
+        if(item_weight <= 0) {
+            continue;
+        }
+        // Increasing capacity so the same item can be added again
+        for(int curr_capacity = item_weight; curr_capacity <= capacity; curr_capacity++) {
+            long prev_side_value = best[curr_capacity - item_weight] + item_value;
+            if(prev_side_value > best[curr_capacity]) {
+                best[curr_capacity] = prev_side_value;
+                last[curr_capacity] = i;
+            }
+        }
+    }
+
+    vector<int> items_in_sack;
+    int curr_capacity = capacity;
+    while(curr_capacity > 0 && last[curr_capacity] != -1) {
+        int index = last[curr_capacity];
+        items_in_sack.push_back(index);
+        curr_capacity -= items[index].weight;
+    }
+    sort(items_in_sack.rbegin(), items_in_sack.rend());
+    return items_in_sack;
+}
+
+/**
+ * @brief Weight, value and used items (as a bitmask) of a subset of items.
+ */
+struct Subset
+{
+    long weight, value;
+    uint32_t mask;
+};
+
+/**
+ * @brief Weight and value of every subset of items [first, first + count), subset with mask m at index m.
+ * Each subset adds its lowest item to the subset without it, O(2^count).
+ */
+vector<Subset> all_subsets(const vector<long>& weights, const vector<long>& values, int first, int count) {
+    vector<Subset> subsets(1 << count);
+    subsets[0] = Subset{ 0, 0, 0 };
+    for(uint32_t mask = 1; mask < subsets.size(); mask++) {
+        int lowest = __builtin_ctz(mask);
+        const Subset& rest = subsets[mask & (mask - 1)];
+        subsets[mask] = Subset{ rest.weight + weights[first + lowest], rest.value + values[first + lowest], mask };
+    }
+    return subsets;
+}
+
+// Most items meet in the middle can take, each half is listed as 2^(N/2) subsets with a 32 bit mask
+const int MAX_MITM_ITEMS = 40;
+
+/**
+ * @brief Solves the 0/1 napsack problem for at most 40 items and any capacity with meet in the middle.
+ * All subsets of both halves are listed, the second half is sorted on weight and only subsets with more
+ * value than every lighter one are kept. Every subset of the first half is then paired with the best
+ * second half subset that fits through binary search. Time complexity O(2^(N/2)*N), independent of capacity.
+ * 
+ * @param weights Weight of every item.
+ * @param values Value of every item.
+ * @param capacity Max capacity of the sack.
+ * @return vector<int> of indexes of which items are used in decreasing order.
+ */
+vector<int> meet_in_middle_knapsack(const vector<long>& weights, const vector<long>& values, long capacity) {
+    int num_items = weights.size();
+    int first_half = num_items / 2;
+    vector<Subset> first = all_subsets(weights, values, 0, first_half);
+    vector<Subset> second = all_subsets(weights, values, first_half, num_items - first_half);
+
+    sort(second.begin(), second.end(), [](const Subset& a, const Subset& b) {
+        return a.weight < b.weight || (a.weight == b.weight && a.value > b.value);
+    });
+    // Remove subsets that are heavier but not more valuable than a previous one
+    vector<Subset> frontier;
+    for(const Subset& subset : second) {
+        if(frontier.empty() || subset.value > frontier.back().value) {
+            frontier.push_back(subset);
+        }
+    }
+
+    long best_value = -1;
+    uint32_t best_first = 0, best_second = 0;
+    for(const Subset& subset : first) {
+        if(subset.weight > capacity) {
+            continue;
+        }
+        long space = capacity - subset.weight;
+        // Heaviest (so most valuable) second half subset that fits
+        auto it = upper_bound(frontier.begin(), frontier.end(), space, [](long w, const Subset& s) {
+            return w < s.weight;
+        });
+        if(it == frontier.begin()) {
+            continue;
+        }
+        --it;
+        if(subset.value + it->value > best_value) {
+            best_value = subset.value + it->value;
+            best_first = subset.mask;
+            best_second = it->mask;
+        }
+    }
+
+    vector<int> items_in_sack;
+    if(best_value < 0) {
+        return items_in_sack;
+    }
+    for(int i = num_items - 1; i >= 0; i--) {
+        bool used = i < first_half ? (best_first >> i) & 1 : (best_second >> (i - first_half)) & 1;
+        if(used) {
+            items_in_sack.push_back(i);
+        }
+    }
     return items_in_sack;
 }
 
@@ -93,27 +381,79 @@ vector<int> knapsack(vector<Item> items, int capacity) {
  * 
  * @return int 
  */
-int main() {
+int main(int argc, char* argv[]) {
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
     cout.tie(NULL);
 
-    int capacity;
+    // Arguments are the variant (01, bounded, unbounded or mitm) and the number of threads
+    string variant = "01";
+    int num_threads = 1;
+    for(int arg = 1; arg < argc; arg++) {
+        if(isdigit((unsigned char) argv[arg][0])) {
+            num_threads = atoi(argv[arg]);
+        } else {
+            variant = argv[arg];
+        }
+    }
+    if(variant != "01" && variant != "bounded" && variant != "unbounded" && variant != "mitm") {
+        cerr << "usage: " << argv[0] << " [01 | bounded | unbounded | mitm] [threads]\n";
+        return 1;
+    }
+
+    long capacity;
     int num_items;
     // More than one testcase can be tested in one run.
     while(cin >> capacity >> num_items) {
-        int value;
-        int weight;
+        if(variant == "mitm" && num_items > MAX_MITM_ITEMS) {
+            cerr << "mitm takes at most " << MAX_MITM_ITEMS << " items\n";
+            return 1;
+        }
+        // The variants with rows keep capacities, weights and values in int
+        bool fits_int = capacity >= 0 && capacity <= INT_MAX;
+        long total_value = 0;
+        long value;
+        long weight;
         vector<Item> items;
-        // Make items with given values
+        vector<int> counts;
+        vector<long> weights, values;
+        // Make items with given values, bounded items also have a count
         for(int i = 0; i < num_items; i++) {
             cin >> value >> weight;
+            long count = 1;
+            if(variant == "bounded") {
+                cin >> count;
+                counts.push_back(count);
+            }
+            fits_int &= weight >= INT_MIN && weight <= INT_MAX && value >= INT_MIN && value <= INT_MAX;
+            fits_int &= count >= 0 && count <= INT_MAX;
+            // Every item used as often as it can is the most value the int rows have to hold (unbounded has long rows)
+            if(value > 0 && fits_int && variant != "unbounded") {
+                total_value += value * count;
+                fits_int &= total_value <= INT_MAX;
+            }
             // Make item with its specific values, index +1 for right index
-            Item t{ weight, value, i + 1 };
+            Item t{ (int) weight, (int) value, i + 1 };
             items.push_back(t);
+            weights.push_back(weight);
+            values.push_back(value);
         }
 
-        vector<int> items_in_sack = knapsack(items, capacity);
+        if(variant != "mitm" && !fits_int) {
+            cerr << "Capacity, weights and values must fit in int, larger ones only work with mitm\n";
+            return 1;
+        }
+
+        vector<int> items_in_sack;
+        if(variant == "bounded") {
+            items_in_sack = bounded_knapsack(items, counts, capacity, num_threads);
+        } else if(variant == "unbounded") {
+            items_in_sack = unbounded_knapsack(items, capacity);
+        } else if(variant == "mitm") {
+            items_in_sack = meet_in_middle_knapsack(weights, values, capacity);
+        } else {
+            items_in_sack = knapsack(items, capacity, num_threads);
+        }
         // Outputs
         cout << items_in_sack.size() << "\n";
         for(auto item = items_in_sack.rbegin(); item != items_in_sack.rend(); ++item) {
@@ -0,0 +1,481 @@
+/**
+ * @file max_flow.cpp
+ * @author Daniel Purgal, danpu323 (danpu323@student.liu.se)
+ * @brief Find the maximum flow from a source to a sink, and how much flow every edge gets. Uses highest
+ * label push-relabel with global relabeling and the gap heuristic, O(V^2*sqrt(E)), or Dinic's algorithm
+ * which is O(E*sqrt(E)) on graphs where all capacities are 1.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <queue>
+#include <string>
+#include <tuple>
+using namespace std;
+
+/**
+ * @brief Directed graph with capacities. When the graph is built every node has its arcs next to each
+ * other in one array (CSR): arcs of node u are head[u] to head[u + 1]. Every edge gives a forward arc and
+ * a reverse arc with capacity 0, and each arc knows the position of its pair, so pushing flow along an arc
+ * gives the same amount of residual capacity back on the pair.
+ */
+class FlowGraph {
+public:
+    /**
+     * @brief Construct a new FlowGraph object without edges.
+     *
+     * @param num_nodes Number of nodes.
+     */
+    FlowGraph(int num_nodes) : num_nodes(num_nodes) {}
+
+    /**
+     * @brief Add an edge, has to be done before any flow is found.
+     *
+     * @param from
+     * @param to
+     * @param capacity
+     * @return int index of the edge, used with get_flow.
+     */
+    int add_edge(int from, int to, long capacity) {
+        edges.push_back({from, to, capacity});
+        return edges.size() - 1;
+    }
+
+    /**
+     * @brief Max flow with highest label push-relabel. Nodes with excess flow push it to neighbours one
+     * step lower, and are lifted when they cannot. The active node with the highest label is always taken.
+     * All labels are set to the real residual distance to the sink (or n + distance to the source) by
+     * a breadth first search at the start and every time enough relabels have been done. When no node has
+     * some label below n anymore, the nodes above it cannot reach the sink, and are lifted to n + 1 at once
+     * (gap heuristic). Labels go up to 2n, so excess that cannot reach the sink goes back to the source and
+     * the result is a real flow.
+     *
+     * @param source
+     * @param sink
+     * @return long value of the flow.
+     */
+    long push_relabel(int source, int sink) {
+        build();
+        if(source == sink) {
+            return 0;
+        }
+        int max_height = 2 * num_nodes;
+        height.assign(num_nodes, 0);
+        excess.assign(num_nodes, 0);
+        current.assign(head.begin(), head.end() - 1);
+        height_count.assign(max_height + 1, 0);
+        active.assign(max_height + 1, {});
+
+        // Highest label that can have an active node
+        int highest = -1;
+        auto push = [&](int u, int arc, long amount) {
+            int v = arc_to[arc];
+            if(excess[v] == 0 && v != source && v != sink) {
+                active[height[v]].push_back(v);
+                highest = max(highest, height[v]);
+            }
+            arc_capacity[arc] -= amount;
+            arc_capacity[arc_reverse[arc]] += amount;
+            excess[u] -= amount;
+            excess[v] += amount;
+        };
+
+        // Send as much as possible out of the source
+        for(int arc = head[source]; arc < head[source + 1]; arc++) {
+            if(arc_capacity[arc] > 0) {
+                push(source, arc, arc_capacity[arc]);
+            }
+        }
+        highest = global_relabel(source, sink);
+
+        long work = 0;
+        const long work_limit = 6L * num_nodes + arc_to.size();
+        while(true) {
+            while(highest >= 0 && active[highest].empty()) {
+                highest--;
+            }
+            if(highest < 0) {
+                break;
+            }
+            int u = active[highest].back();
+            active[highest].pop_back();
+            // Nodes lifted by the gap heuristic are also left in their old bucket
+            if(height[u] != highest || excess[u] == 0) {
+                continue;
+            }
+
+            // Discharge u
+            while(excess[u] > 0) {
+                if(current[u] == head[u + 1]) {
+                    // Relabel, one above the lowest neighbour it has capacity to
+                    int old_height = height[u];
+                    int new_height = max_height;
+                    for(int arc = head[u]; arc < head[u + 1]; arc++) {
+                        if(arc_capacity[arc] > 0) {
+                            new_height = min(new_height, height[arc_to[arc]] + 1);
+                        }
+                    }
+                    height_count[old_height]--;
+                    height[u] = new_height;
+                    height_count[new_height]++;
+                    current[u] = head[u];
+                    work += head[u + 1] - head[u] + 12;
+                    if(height_count[old_height] == 0 && old_height < num_nodes) {
+                        highest = max(highest, gap(old_height, source));
+                    }
+                    if(height[u] == max_height) {
+                        break;
+                    }
+                } else {
+                    int arc = current[u];
+                    if(arc_capacity[arc] > 0 && height[u] == height[arc_to[arc]] + 1) {
+                        push(u, arc, min(excess[u], arc_capacity[arc]));
+                    } else {
+                        current[u]++;
+                    }
+                }
+            }
+
+            if(work > work_limit) {
+                work = 0;
+                highest = global_relabel(source, sink);
+            }
+        }
+        return excess[sink];
+    }
+
+    /**
+     * @brief Max flow with Dinic's algorithm. A breadth first search gives every node its distance from
+     * the source, then paths that only go one step further every arc are augmented until there are no more
+     * (a blocking flow), and it is repeated until the sink cannot be reached.
+     *
+     * @param source
+     * @param sink
+     * @return long value of the flow.
+     */
+    long dinic(int source, int sink) {
+        build();
+        if(source == sink) {
+            return 0;
+        }
+        long flow = 0;
+        level.assign(num_nodes, -1);
+        while(find_levels(source, sink)) {
+            current.assign(head.begin(), head.end() - 1);
+            flow += blocking_flow(source, sink);
+        }
+        return flow;
+    }
+
+    /**
+     * @brief Flow through an edge after push_relabel or dinic.
+     *
+     * @param edge Index from add_edge.
+     * @return long
+     */
+    long get_flow(int edge) const {
+        return get<2>(edges[edge]) - arc_capacity[edge_arc[edge]];
+    }
+
+    /**
+     * @brief Nodes on the source side of a minimum cut, the ones the source can still reach in the
+     * residual graph after the max flow.
+     *
+     * @param source
+     * @return vector<int> of the nodes, in increasing order.
+     */
+    vector<int> min_cut(int source) const {
+        vector<bool> reached(num_nodes, false);
+        vector<int> queue{source};
+        reached[source] = true;
+        for(size_t i = 0; i < queue.size(); i++) {
+            int u = queue[i];
+            for(int arc = head[u]; arc < head[u + 1]; arc++) {
+                if(arc_capacity[arc] > 0 && !reached[arc_to[arc]]) {
+                    reached[arc_to[arc]] = true;
+                    queue.push_back(arc_to[arc]);
+                }
+            }
+        }
+        sort(queue.begin(), queue.end());
+        return queue;
+    }
+
+    int get_num_edges() const {
+        return edges.size();
+    }
+
+    tuple<int, int, long> get_edge(int edge) const {
+        return edges[edge];
+    }
+
+private:
+    int num_nodes;
+    // Edges as added: from, to, capacity
+    vector<tuple<int, int, long>> edges;
+    // CSR residual graph, and the forward arc of every edge
+    vector<int> head;
+    vector<int> arc_to;
+    vector<int> arc_reverse;
+    vector<long> arc_capacity;
+    vector<int> edge_arc;
+    // Push-relabel state
+    vector<int> height;
+    vector<long> excess;
+    vector<int> current;
+    vector<int> height_count;
+    vector<vector<int>> active;
+    // Dinic state
+    vector<int> level;
+
+    /**
+     * @brief Put the arcs in CSR order. O(V + E).
+     */
+    void build() {
+        head.assign(num_nodes + 1, 0);
+        for(const tuple<int, int, long>& edge : edges) {
+            head[get<0>(edge) + 1]++;
+            head[get<1>(edge) + 1]++;
+        }
+        for(int node = 0; node < num_nodes; node++) {
+            head[node + 1] += head[node];
+        }
+        vector<int> fill_pos(head.begin(), head.end() - 1);
+        arc_to.resize(2 * edges.size());
+        arc_reverse.resize(2 * edges.size());
+        arc_capacity.resize(2 * edges.size());
+        edge_arc.resize(edges.size());
+        for(size_t i = 0; i < edges.size(); i++) {
+            int from = get<0>(edges[i]), to = get<1>(edges[i]);
+            int forward = fill_pos[from]++;
+            int backward = fill_pos[to]++;
+            arc_to[forward] = to;
+            arc_to[backward] = from;
+            arc_reverse[forward] = backward;
+            arc_reverse[backward] = forward;
+            arc_capacity[forward] = get<2>(edges[i]);
+            arc_capacity[backward] = 0;
+            edge_arc[i] = forward;
+        }
+    }
+
+    /**
+     * @brief Set every label to the residual distance to the sink, or n + the distance to the source for
+     * nodes that cannot reach the sink, and rebuild the active buckets.
+     *
+     * @return int highest label with an active node, -1 if none.
+     */
+    int global_relabel(int source, int sink) {
+        int max_height = 2 * num_nodes;
+        fill(height.begin(), height.end(), max_height);
+        // The source keeps label n, so the search from the sink does not go through it
+        height[sink] = 0;
+        height[source] = num_nodes;
+        vector<int> queue;
+        for(int root : {sink, source}) {
+            queue.assign(1, root);
+            for(size_t i = 0; i < queue.size(); i++) {
+                int v = queue[i];
+                for(int arc = head[v]; arc < head[v + 1]; arc++) {
+                    // The pair of arc goes from u to v
+                    int u = arc_to[arc];
+                    if(height[u] == max_height && arc_capacity[arc_reverse[arc]] > 0) {
+                        height[u] = height[v] + 1;
+                        queue.push_back(u);
+                    }
+                }
+            }
+        }
+
+        fill(height_count.begin(), height_count.end(), 0);
+        for(vector<int>& bucket : active) {
+            bucket.clear();
+        }
+        int highest = -1;
+        for(int u = 0; u < num_nodes; u++) {
+            height_count[height[u]]++;
+            current[u] = head[u];
+            if(excess[u] > 0 && u != source && u != sink && height[u] < max_height) {
+                active[height[u]].push_back(u);
+                highest = max(highest, height[u]);
+            }
+        }
+        return highest;
+    }
+
+    /**
+     * @brief No node has label gap_height anymore, so nodes between it and n cannot reach the sink and
+     * are lifted to n + 1.
+     *
+     * @return int highest label of an active lifted node, -1 if none.
+     */
+    int gap(int gap_height, int source) {
+        int highest = -1;
+        for(int u = 0; u < num_nodes; u++) {
+            if(gap_height < height[u] && height[u] < num_nodes && u != source) {
+                height_count[height[u]]--;
+                height[u] = num_nodes + 1;
+                height_count[height[u]]++;
+                current[u] = head[u];
+                if(excess[u] > 0) {
+                    active[height[u]].push_back(u);
+                    highest = height[u];
+                }
+            }
+        }
+        return highest;
+    }
+
+    /**
+     * @brief Breadth first search from the source over arcs with capacity left.
+     *
+     * @return true if the sink was reached.
+     */
+    bool find_levels(int source, int sink) {
+        fill(level.begin(), level.end(), -1);
+        level[source] = 0;
+        vector<int> queue{source};
+        for(size_t i = 0; i < queue.size(); i++) {
+            int u = queue[i];
+            for(int arc = head[u]; arc < head[u + 1]; arc++) {
+                int v = arc_to[arc];
+                if(arc_capacity[arc] > 0 && level[v] == -1) {
+                    level[v] = level[u] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+        return level[sink] != -1;
+    }
+
+    /**
+     * @brief Push flow along paths from source to sink where every arc goes one level up until there are
+     * no more (a blocking flow). Done with a stack instead of recursion since paths can be as long as the
+     * graph. After a path is augmented only the part after its first full arc is thrown away, current[u]
+     * skips arcs that lead nowhere, and dead end nodes are taken out of the levels.
+     *
+     * @return long flow pushed.
+     */
+    long blocking_flow(int source, int sink) {
+        long flow = 0;
+        vector<int> path;
+        int u = source;
+        while(true) {
+            if(u == sink) {
+                long pushed = arc_capacity[path[0]];
+                for(int arc : path) {
+                    pushed = min(pushed, arc_capacity[arc]);
+                }
+                size_t first_full = path.size();
+                for(size_t i = 0; i < path.size(); i++) {
+                    arc_capacity[path[i]] -= pushed;
+                    arc_capacity[arc_reverse[path[i]]] += pushed;
+                    if(arc_capacity[path[i]] == 0 && first_full == path.size()) {
+                        first_full = i;
+                    }
+                }
+                flow += pushed;
+                path.resize(first_full);
+                u = path.empty() ? source : arc_to[path.back()];
+                continue;
+            }
+
+            int& arc = current[u];
+            while(arc < head[u + 1] && !(arc_capacity[arc] > 0 && level[arc_to[arc]] == level[u] + 1)) {
+                arc++;
+            }
+            if(arc < head[u + 1]) {
+                path.push_back(arc);
+                u = arc_to[arc];
+                continue;
+            }
+
+            // Dead end, go back one step
+            level[u] = -1;
+            if(path.empty()) {
+                return flow;
+            }
+            int back = path.back();
+            path.pop_back();
+            u = arc_to[arc_reverse[back]];
+            current[u]++;
+        }
+    }
+};
+
+/**
+ * @brief Main function, takes input from terminal and outputs answer to terminal.
+ * Reads n m s t and the m edges u v c. Prints n, the flow and the number of node pairs with flow, then
+ * the flow between every such pair (flow both ways between two nodes cancels out). Passing "dinic" as
+ * argument uses Dinic instead of push-relabel, passing "cut" prints the source side of a minimum cut.
+ *
+ * @return int
+ */
+int main(int argc, char* argv[]) {
+    ios_base::sync_with_stdio(false);
+    cin.tie(NULL);
+    cout.tie(NULL);
+
+    bool use_dinic = false, print_cut = false;
+    for(int i = 1; i < argc; i++) {
+        use_dinic |= string(argv[i]) == "dinic";
+        print_cut |= string(argv[i]) == "cut";
+    }
+
+    int num_nodes, num_edges, source, sink;
+    cin >> num_nodes >> num_edges >> source >> sink;
+    FlowGraph graph(num_nodes);
+    for(int i = 0; i < num_edges; i++) {
+        int from, to;
+        long capacity;
+        cin >> from >> to >> capacity;
+        graph.add_edge(from, to, capacity);
+    }
+
+    long flow = use_dinic ? graph.dinic(source, sink) : graph.push_relabel(source, sink);
+
+    string output;
+    if(print_cut) {
+        vector<int> cut = graph.min_cut(source);
+        output += to_string(cut.size()) + "\n";
+        for(int node : cut) {
+            output += to_string(node) + "\n";
+        }
+        cout << output;
+        return 0;
+    }
+
+    // Flow per node pair, the smaller node first and negative flow going the other way
+    vector<tuple<int, int, long>> pair_flows;
+    for(int edge = 0; edge < graph.get_num_edges(); edge++) {
+        long edge_flow = graph.get_flow(edge);
+        if(edge_flow > 0) {
+            int from = get<0>(graph.get_edge(edge)), to = get<1>(graph.get_edge(edge));
+            pair_flows.push_back(from < to ? make_tuple(from, to, edge_flow) : make_tuple(to, from, -edge_flow));
+        }
+    }
+    sort(pair_flows.begin(), pair_flows.end());
+    vector<tuple<int, int, long>> used;
+    for(size_t i = 0; i < pair_flows.size();) {
+        int first = get<0>(pair_flows[i]), second = get<1>(pair_flows[i]);
+        long net = 0;
+        for(; i < pair_flows.size() && get<0>(pair_flows[i]) == first && get<1>(pair_flows[i]) == second; i++) {
+            net += get<2>(pair_flows[i]);
+        }
+        if(net > 0) {
+            used.push_back({first, second, net});
+        } else if(net < 0) {
+            used.push_back({second, first, -net});
+        }
+    }
+
+    output += to_string(num_nodes) + " " + to_string(flow) + " " + to_string(used.size()) + "\n";
+    for(const tuple<int, int, long>& edge : used) {
+        output += to_string(get<0>(edge)) + " " + to_string(get<1>(edge)) + " " + to_string(get<2>(edge)) + "\n";
+    }
+    cout << output;
+    return 0;
+}
@@ -13,15 +13,51 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <string_view>
+#include <iterator>
+#include <cctype>
 using namespace std;
 
+/**
+ * @brief Read all of standard input into one buffer, tokens are then views into this buffer.
+ *
+ * @return string with the whole input.
+ */
+string read_input() {
+    return string(istreambuf_iterator<char>(cin), istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Seperates a string on whitespace without copying, the views point into str.
+ *
+ * @param str
+ * @return vector<string_view> of every word in str.
+ */
+vector<string_view> tokenize(string_view str) {
+    vector<string_view> tokens;
+    size_t i = 0;
+    while(i < str.size()) {
+        while(i < str.size() && isspace((unsigned char) str[i])) {
+            i++;
+        }
+        size_t start = i;
+        while(i < str.size() && !isspace((unsigned char) str[i])) {
+            i++;
+        }
+        if(i > start) {
+            tokens.push_back(str.substr(start, i - start));
+        }
+    }
+    return tokens;
+}
+
 /**
  * @brief Create a longest proper prefix suffix array.
  * 
  * @param pattern 
  * @return vector<int> of longest prefix suffix (lps) 
  */
-vector<int> pre_process(string pattern) {
+vector<int> pre_process(string_view pattern) {
     vector<int> lps(pattern.size(), 0);
     int iter = 1;
     int ps_length = 0;
@@ -50,7 +86,7 @@ vector<int> pre_process(string pattern) {
  * @param text 
  * @return vector<int> With all positions the of mached pattern in the text.
  */
-vector<int> find_maches(string pattern, string text) {
+vector<int> find_maches(string_view pattern, string_view text) {
     vector<int> matches{};
     vector<int> lps = pre_process(pattern);
     int pattern_size = pattern.size();
@@ -88,9 +124,9 @@ bool compare_intervals(Interval a, Interval b) {
     return a.end < b.end;
 }
 
-int find_most_maches(vector<string> patterns, string text) {
+int find_most_maches(const vector<string_view>& patterns, string_view text) {
     vector<Interval> intervals;
-    for(string pattern : patterns) {
+    for(string_view pattern : patterns) {
         vector<int> matches = find_maches(pattern, text);
         for(auto match : matches) {
             intervals.push_back(Interval{match, match + int(pattern.size())-1});
@@ -124,14 +160,19 @@ int main(){
     cin.tie(NULL);
     cout.tie(NULL);
 
-    vector<string> patterns;
-    string pattern, text;
-    while(cin >> pattern && pattern != "#") {
-        patterns.push_back(pattern);
+    string input = read_input();
+    vector<string_view> tokens = tokenize(input);
+    size_t token = 0;
+
+    vector<string_view> patterns;
+    while(token < tokens.size() && tokens[token] != "#") {
+        patterns.push_back(tokens[token++]);
     }
+    token++;
 
     string total_text = "";
-    while(cin >> text && text != "#") {
+    while(token < tokens.size() && tokens[token] != "#") {
+        string_view text = tokens[token++];
         total_text += text;
         if(text.back() == '|') {
             total_text.pop_back();
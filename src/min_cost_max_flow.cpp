@@ -0,0 +1,524 @@
+/**
+ * @file min_cost_max_flow.cpp
+ * @author Daniel Purgal, danpu323 (danpu323@student.liu.se)
+ * @brief Find the maximum flow from a source to a sink that has the lowest total cost. Uses successive
+ * shortest paths, where the first potentials come from Bellman-Ford and then every path is found with
+ * Dijkstra on the reduced costs, O(F*(E+V)log(V)) for a flow of size F. There is also cost scaling
+ * (Goldberg-Tarjan) with global price updates, O(V^2*E*log(V*C)) in the worst case whatever the size of
+ * the flow. It is the one to use when the flow is large and needs many paths, but when few paths are
+ * needed successive shortest paths is faster, so it is only the default when there is a negative cycle.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <queue>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <utility>
+using namespace std;
+static const long INF = numeric_limits<long>::max();
+
+/**
+ * @brief Directed graph with capacities and costs per unit of flow. When the graph is built every node has
+ * its arcs next to each other in one array (CSR): arcs of node u are head[u] to head[u + 1]. Every edge
+ * gives a forward arc and a reverse arc with capacity 0 and the negative cost, and each arc knows the
+ * position of its pair.
+ */
+class CostFlowGraph {
+public:
+    /**
+     * @brief Construct a new CostFlowGraph object without edges.
+     *
+     * @param num_nodes Number of nodes.
+     */
+    CostFlowGraph(int num_nodes) : num_nodes(num_nodes) {}
+
+    /**
+     * @brief Add an edge, has to be done before any flow is found.
+     *
+     * @param from
+     * @param to
+     * @param capacity
+     * @param cost Cost per unit of flow, can be negative.
+     * @return int index of the edge, used with get_flow.
+     */
+    int add_edge(int from, int to, long capacity, long cost) {
+        edges.push_back({from, to, capacity, cost});
+        return edges.size() - 1;
+    }
+
+    /**
+     * @brief Min cost max flow with successive shortest paths. Flow is always sent along the cheapest path
+     * left. With potentials p the reduced cost cost + p[u] - p[v] of every arc with capacity left is never
+     * negative, so Dijkstra can be used, and adding the distances to the potentials keeps it that way after
+     * the path is used. The first potentials are the distances from bellman, which allows negative costs.
+     *
+     * @param source
+     * @param sink
+     * @param flow Set to the size of the flow.
+     * @param cost Set to the cost of the flow.
+     * @return true if done,
+     * @return false if there is a negative cycle (then cost_scaling has to be used).
+     */
+    bool successive_shortest_paths(int source, int sink, long& flow, long& cost) {
+        build();
+        flow = 0;
+        cost = 0;
+        if(!bellman()) {
+            return false;
+        }
+
+        vector<long> dist(num_nodes);
+        vector<int> prev_arc(num_nodes);
+        while(source != sink) {
+            dijkstra(source, dist, prev_arc);
+            if(dist[sink] == INF) {
+                break;
+            }
+            for(int node = 0; node < num_nodes; node++) {
+                if(dist[node] != INF) {
+                    potentials[node] += dist[node];
+                }
+            }
+
+            // Send as much as the path can take
+            long pushed = INF;
+            for(int node = sink; node != source; node = arc_to[arc_reverse[prev_arc[node]]]) {
+                pushed = min(pushed, arc_capacity[prev_arc[node]]);
+            }
+            for(int node = sink; node != source; node = arc_to[arc_reverse[prev_arc[node]]]) {
+                int arc = prev_arc[node];
+                arc_capacity[arc] -= pushed;
+                arc_capacity[arc_reverse[arc]] += pushed;
+                cost += pushed * arc_cost[arc];
+            }
+            flow += pushed;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Min cost max flow with cost scaling. First any max flow is found with Dinic, then it is made
+     * cheaper without changing its size. Costs are multiplied by n + 1 and the flow is made eps-optimal
+     * (no arc with capacity left has reduced cost below -eps) for smaller and smaller eps: every round all
+     * arcs with negative reduced cost are filled, and the excess this makes is pushed along arcs with
+     * negative reduced cost, lowering the price of a node when it has none. When eps is 1 every cycle
+     * with capacity left has cost above -1 in the real costs, so none is negative and the flow is optimal.
+     * Also works with negative cycles.
+     *
+     * @param source
+     * @param sink
+     * @param flow Set to the size of the flow.
+     * @param cost Set to the cost of the flow.
+     */
+    void cost_scaling(int source, int sink, long& flow, long& cost) {
+        build();
+        flow = source == sink ? 0 : dinic(source, sink);
+
+        long scale = num_nodes + 1;
+        long eps = 0;
+        for(long& arc_cost_value : arc_cost) {
+            arc_cost_value *= scale;
+            eps = max(eps, abs(arc_cost_value));
+        }
+        potentials.assign(num_nodes, 0);
+        excess.assign(num_nodes, 0);
+        while(eps > 1) {
+            eps = max(1L, eps / ALPHA);
+            refine(eps);
+        }
+        for(long& arc_cost_value : arc_cost) {
+            arc_cost_value /= scale;
+        }
+
+        cost = 0;
+        for(int edge = 0; edge < (int) edges.size(); edge++) {
+            cost += get_flow(edge) * get<3>(edges[edge]);
+        }
+    }
+
+    /**
+     * @brief Flow through an edge after successive_shortest_paths or cost_scaling.
+     *
+     * @param edge Index from add_edge.
+     * @return long
+     */
+    long get_flow(int edge) const {
+        return get<2>(edges[edge]) - arc_capacity[edge_arc[edge]];
+    }
+
+private:
+    // How much eps is divided by every round of cost scaling
+    static constexpr long ALPHA = 16;
+
+    int num_nodes;
+    // Edges as added: from, to, capacity, cost
+    vector<tuple<int, int, long, long>> edges;
+    // CSR residual graph, and the forward arc of every edge
+    vector<int> head;
+    vector<int> arc_to;
+    vector<int> arc_reverse;
+    vector<long> arc_capacity;
+    vector<long> arc_cost;
+    vector<int> edge_arc;
+    // Potentials (prices in cost scaling), excess and current arc of every node
+    vector<long> potentials;
+    vector<long> excess;
+    vector<int> current;
+    vector<int> level;
+
+    /**
+     * @brief Put the arcs in CSR order. O(V + E).
+     */
+    void build() {
+        head.assign(num_nodes + 1, 0);
+        for(const tuple<int, int, long, long>& edge : edges) {
+            head[get<0>(edge) + 1]++;
+            head[get<1>(edge) + 1]++;
+        }
+        for(int node = 0; node < num_nodes; node++) {
+            head[node + 1] += head[node];
+        }
+        vector<int> fill_pos(head.begin(), head.end() - 1);
+        arc_to.resize(2 * edges.size());
+        arc_reverse.resize(2 * edges.size());
+        arc_capacity.resize(2 * edges.size());
+        arc_cost.resize(2 * edges.size());
+        edge_arc.resize(edges.size());
+        for(size_t i = 0; i < edges.size(); i++) {
+            int from = get<0>(edges[i]), to = get<1>(edges[i]);
+            int forward = fill_pos[from]++;
+            int backward = fill_pos[to]++;
+            arc_to[forward] = to;
+            arc_to[backward] = from;
+            arc_reverse[forward] = backward;
+            arc_reverse[backward] = forward;
+            arc_capacity[forward] = get<2>(edges[i]);
+            arc_capacity[backward] = 0;
+            arc_cost[forward] = get<3>(edges[i]);
+            arc_cost[backward] = -get<3>(edges[i]);
+            edge_arc[i] = forward;
+        }
+    }
+
+    /**
+     * @brief Find shortest paths using Bellman-Ford algorithm, over the arcs with capacity left. Every node
+     * starts at distance 0, as if an extra node had a free arc to all of them, so the distances work as
+     * potentials for the whole graph. They are saved as potentials.
+     *
+     * @return true if done,
+     * @return false if there is a negative cycle.
+     */
+    bool bellman() {
+        potentials.assign(num_nodes, 0);
+
+        // Relaxation (num_nodes - 1) times, stop early when nothing changes
+        for(int round = 0; round < num_nodes; round++) {
+            bool updated = false;
+            for(int u = 0; u < num_nodes; u++) {
+                for(int arc = head[u]; arc < head[u + 1]; arc++) {
+                    int v = arc_to[arc];
+                    if(arc_capacity[arc] > 0 && potentials[u] + arc_cost[arc] < potentials[v]) {
+                        potentials[v] = potentials[u] + arc_cost[arc];
+                        updated = true;
+                    }
+                }
+            }
+            if(!updated) {
+                return true;
+            }
+        }
+        // Still updating after n rounds, neg cycle found
+        return false;
+    }
+
+    /**
+     * @brief Dijkstra from the source with the reduced costs, over arcs with capacity left.
+     *
+     * @param source
+     * @param dist Set to the reduced distance of every node, INF if not reached.
+     * @param prev_arc Set to the arc every reached node was reached by.
+     */
+    void dijkstra(int source, vector<long>& dist, vector<int>& prev_arc) {
+        fill(dist.begin(), dist.end(), INF);
+        dist[source] = 0;
+        priority_queue<pair<long, int>, vector<pair<long, int>>, greater<pair<long, int>>> queue;
+        queue.push({0, source});
+        while(!queue.empty()) {
+            auto [node_dist, u] = queue.top();
+            queue.pop();
+            // Already found with a shorter distance
+            if(node_dist != dist[u]) {
+                continue;
+            }
+            for(int arc = head[u]; arc < head[u + 1]; arc++) {
+                int v = arc_to[arc];
+                if(arc_capacity[arc] == 0) {
+                    continue;
+                }
+                long new_dist = node_dist + arc_cost[arc] + potentials[u] - potentials[v];
+                if(new_dist < dist[v]) {
+                    dist[v] = new_dist;
+                    prev_arc[v] = arc;
+                    queue.push({new_dist, v});
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Make the flow eps-optimal. Arcs with negative reduced cost are filled, then nodes with excess
+     * push it along arcs with negative reduced cost (first in first out), and when they have none left
+     * their price is lowered to one eps below what makes the cheapest arc free. On long graphs excess
+     * would need a relabel for every step it moves, so global_price_update is run at the start and after
+     * every n relabels.
+     *
+     * @param eps
+     */
+    void refine(long eps) {
+        auto reduced_cost = [&](int u, int arc) {
+            return arc_cost[arc] + potentials[u] - potentials[arc_to[arc]];
+        };
+
+        for(int u = 0; u < num_nodes; u++) {
+            for(int arc = head[u]; arc < head[u + 1]; arc++) {
+                if(arc_capacity[arc] > 0 && reduced_cost(u, arc) < 0) {
+                    long amount = arc_capacity[arc];
+                    arc_capacity[arc] = 0;
+                    arc_capacity[arc_reverse[arc]] += amount;
+                    excess[u] -= amount;
+                    excess[arc_to[arc]] += amount;
+                }
+            }
+        }
+
+        global_price_update(eps);
+        int relabels = 0;
+        queue<int> active;
+        for(int u = 0; u < num_nodes; u++) {
+            if(excess[u] > 0) {
+                active.push(u);
+            }
+        }
+        while(!active.empty()) {
+            int u = active.front();
+            active.pop();
+            while(excess[u] > 0) {
+                if(current[u] == head[u + 1]) {
+                    // Relabel, and fix all prices at once now and then
+                    long highest = -INF;
+                    for(int arc = head[u]; arc < head[u + 1]; arc++) {
+                        if(arc_capacity[arc] > 0) {
+                            highest = max(highest, potentials[arc_to[arc]] - arc_cost[arc]);
+                        }
+                    }
+                    potentials[u] = highest - eps;
+                    current[u] = head[u];
+                    if(++relabels == num_nodes) {
+                        global_price_update(eps);
+                        relabels = 0;
+                    }
+                    continue;
+                }
+                int arc = current[u];
+                if(arc_capacity[arc] > 0 && reduced_cost(u, arc) < 0) {
+                    int v = arc_to[arc];
+                    long amount = min(excess[u], arc_capacity[arc]);
+                    arc_capacity[arc] -= amount;
+                    arc_capacity[arc_reverse[arc]] += amount;
+                    excess[u] -= amount;
+                    if(excess[v] <= 0 && excess[v] + amount > 0) {
+                        active.push(v);
+                    }
+                    excess[v] += amount;
+                } else {
+                    current[u]++;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Lower the prices so every node with excess has a path of arcs with negative reduced cost to
+     * a node that is missing flow, instead of finding it one relabel at a time (global update). An arc
+     * with capacity left and reduced cost c has length floor(c / eps) + 1, which is 0 for the arcs flow can
+     * be pushed along, and the distance d of every node to a node missing flow is found with one bucket
+     * per distance (Dial), going backwards from those nodes. Lowering every price by d * eps keeps the
+     * flow eps-optimal. Stops when all nodes with excess are reached, nodes not reached are lowered by the
+     * distance it stopped at. O(V + E).
+     *
+     * @param eps
+     */
+    void global_price_update(long eps) {
+        int active_left = 0;
+        vector<int> distance(num_nodes, num_nodes);
+        vector<vector<int>> buckets(num_nodes);
+        for(int u = 0; u < num_nodes; u++) {
+            if(excess[u] > 0) {
+                active_left++;
+            } else if(excess[u] < 0) {
+                distance[u] = 0;
+                buckets[0].push_back(u);
+            }
+        }
+
+        int reached = 0;
+        for(; reached < num_nodes && active_left > 0; reached++) {
+            // Arcs of length 0 add to the bucket that is being gone through
+            for(size_t i = 0; i < buckets[reached].size(); i++) {
+                int v = buckets[reached][i];
+                if(distance[v] != reached) {
+                    continue;
+                }
+                if(excess[v] > 0) {
+                    active_left--;
+                }
+                for(int back = head[v]; back < head[v + 1]; back++) {
+                    int u = arc_to[back];
+                    int arc = arc_reverse[back];
+                    if(arc_capacity[arc] == 0) {
+                        continue;
+                    }
+                    // Rounded down, the reduced cost is at least -eps
+                    long reduced = arc_cost[arc] + potentials[u] - potentials[v];
+                    long length = (reduced >= 0 ? reduced / eps : -((-reduced + eps - 1) / eps)) + 1;
+                    if(reached + length < distance[u]) {
+                        distance[u] = reached + length;
+                        buckets[distance[u]].push_back(u);
+                    }
+                }
+            }
+        }
+
+        for(int u = 0; u < num_nodes; u++) {
+            potentials[u] -= min(distance[u], reached) * eps;
+        }
+        current.assign(head.begin(), head.end() - 1);
+    }
+
+    /**
+     * @brief Any max flow with Dinic's algorithm, the start for cost scaling.
+     *
+     * @return long value of the flow.
+     */
+    long dinic(int source, int sink) {
+        long flow = 0;
+        level.assign(num_nodes, -1);
+        while(find_levels(source, sink)) {
+            current.assign(head.begin(), head.end() - 1);
+            flow += blocking_flow(source, sink);
+        }
+        return flow;
+    }
+
+    /**
+     * @brief Breadth first search from the source over arcs with capacity left.
+     *
+     * @return true if the sink was reached.
+     */
+    bool find_levels(int source, int sink) {
+        fill(level.begin(), level.end(), -1);
+        level[source] = 0;
+        vector<int> queue{source};
+        for(size_t i = 0; i < queue.size(); i++) {
+            int u = queue[i];
+            for(int arc = head[u]; arc < head[u + 1]; arc++) {
+                int v = arc_to[arc];
+                if(arc_capacity[arc] > 0 && level[v] == -1) {
+                    level[v] = level[u] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+        return level[sink] != -1;
+    }
+
+    /**
+     * @brief Push flow along paths from source to sink where every arc goes one level up until there are
+     * no more (a blocking flow), same as in max_flow.cpp.
+     *
+     * @return long flow pushed.
+     */
+    long blocking_flow(int source, int sink) {
+        long flow = 0;
+        vector<int> path;
+        int u = source;
+        while(true) {
+            if(u == sink) {
+                long pushed = arc_capacity[path[0]];
+                for(int arc : path) {
+                    pushed = min(pushed, arc_capacity[arc]);
+                }
+                size_t first_full = path.size();
+                for(size_t i = 0; i < path.size(); i++) {
+                    arc_capacity[path[i]] -= pushed;
+                    arc_capacity[arc_reverse[path[i]]] += pushed;
+                    if(arc_capacity[path[i]] == 0 && first_full == path.size()) {
+                        first_full = i;
+                    }
+                }
+                flow += pushed;
+                path.resize(first_full);
+                u = path.empty() ? source : arc_to[path.back()];
+                continue;
+            }
+
+            int& arc = current[u];
+            while(arc < head[u + 1] && !(arc_capacity[arc] > 0 && level[arc_to[arc]] == level[u] + 1)) {
+                arc++;
+            }
+            if(arc < head[u + 1]) {
+                path.push_back(arc);
+                u = arc_to[arc];
+                continue;
+            }
+
+            // Dead end, go back one step
+            level[u] = -1;
+            if(path.empty()) {
+                return flow;
+            }
+            int back = path.back();
+            path.pop_back();
+            u = arc_to[arc_reverse[back]];
+            current[u]++;
+        }
+    }
+};
+
+/**
+ * @brief Main function, takes input from terminal and outputs answer to terminal.
+ * Reads n m s t and the m edges u v c w (capacity c, cost w per unit). Prints the size of the max flow and
+ * its lowest cost. Passing "scaling" as argument uses cost scaling, which is also used when there is a
+ * negative cycle.
+ *
+ * @return int
+ */
+int main(int argc, char* argv[]) {
+    ios_base::sync_with_stdio(false);
+    cin.tie(NULL);
+    cout.tie(NULL);
+
+    bool use_scaling = argc > 1 && string(argv[1]) == "scaling";
+
+    int num_nodes, num_edges, source, sink;
+    cin >> num_nodes >> num_edges >> source >> sink;
+    CostFlowGraph graph(num_nodes);
+    for(int i = 0; i < num_edges; i++) {
+        int from, to;
+        long capacity, cost;
+        cin >> from >> to >> capacity >> cost;
+        graph.add_edge(from, to, capacity, cost);
+    }
+
+    long flow, cost;
+    if(use_scaling || !graph.successive_shortest_paths(source, sink, flow, cost)) {
+        graph.cost_scaling(source, sink, flow, cost);
+    }
+    cout << flow << " " << cost << "\n";
+    return 0;
+}
@@ -3,31 +3,143 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <string>
+#include <cstdint>
 using namespace std;
 
-int main(){
+/**
+ * @brief Longest common subsequence of two sequences where every value is in a at most once.
+ * Every value in b is replaced by its position in a (values not in a are dropped), a common
+ * subsequence is then an increasing subsequence of these positions. The longest increasing subsequence
+ * is found with patience sorting: tails[k] is the smallest last position of an increasing subsequence
+ * of length k + 1, found with binary search. Time complexity O(N + Mlog(M)).
+ *
+ * @param a Sequence of distinct values.
+ * @param b Sequence.
+ * @param max_value Largest value in a and b.
+ * @return int length of the longest common subsequence.
+ */
+int lcs_distinct(const vector<int>& a, const vector<int>& b, int max_value) {
+    vector<int> rank(max_value + 1, -1);
+    for(int i = 0; i < (int) a.size(); i++) {
+        rank[a[i]] = i;
+    }
+    vector<int> tails;
+    for(int value : b) {
+        if(value < 0 || value > max_value || rank[value] == -1) {
+            continue;
+        }
+        auto it = lower_bound(tails.begin(), tails.end(), rank[value]);
+        if(it == tails.end()) {
+            tails.push_back(rank[value]);
+        } else {
+            *it = rank[value];
+        }
+    }
+    return tails.size();
+}
+
+/**
+ * @brief Longest common subsequence of any two sequences with a bit-parallel algorithm (Allison-Dix,
+ * Hyyrö). Bit i of v is 0 when row i of the DP table increases in the current column, for every value
+ * of b the column is updated for all of a at once: u = v & match, v = (v + u) | (v - u), where match
+ * has the bits of the positions in a equal to the value. The LCS is the number of zero bits in the end.
+ * Time complexity O(N*M/64).
+ *
+ * @param a Sequence.
+ * @param b Sequence.
+ * @return int length of the longest common subsequence.
+ */
+int lcs_bit_parallel(const vector<int>& a, const vector<int>& b) {
+    int length = a.size();
+    int words = (length + 63) / 64;
+    // Positions of every value in a, grouped by value after sorting
+    vector<pair<int, int>> positions(length);
+    for(int i = 0; i < length; i++) {
+        positions[i] = {a[i], i};
+    }
+    sort(positions.begin(), positions.end());
+
+    vector<uint64_t> v(words, ~(uint64_t) 0);
+    vector<uint64_t> match(words, 0);
+    for(int value : b) {
+        auto first = lower_bound(positions.begin(), positions.end(), make_pair(value, -1));
+        auto last = first;
+        while(last != positions.end() && last->first == value) {
+            match[last->second / 64] |= (uint64_t) 1 << (last->second % 64);
+            ++last;
+        }
+        if(first == last) {
+            continue;
+        }
+        uint64_t carry = 0, borrow = 0;
+        for(int w = 0; w < words; w++) {
+            uint64_t u = v[w] & match[w];
+            // v + u with carry between words
+            uint64_t sum = v[w] + u;
+            uint64_t sum_carry = sum < v[w];
+            sum += carry;
+            sum_carry |= sum < carry;
+            // v - u with borrow between words
+            uint64_t difference = v[w] - u;
+            uint64_t difference_borrow = v[w] < u;
+            difference_borrow |= difference < borrow;
+            difference -= borrow;
+            v[w] = sum | difference;
+            carry = sum_carry;
+            borrow = difference_borrow;
+        }
+        for(auto it = first; it != last; ++it) {
+            match[it->second / 64] = 0;
+        }
+    }
+
+    int common = 0;
+    for(int i = 0; i < length; i++) {
+        if(!((v[i / 64] >> (i % 64)) & 1)) {
+            common++;
+        }
+    }
+    return common;
+}
+
+/**
+ * @brief The prince and princess both visit distinct squares of an n x n board, the answer is the
+ * longest sequence of squares both visit in the same order. Passing "bit" as argument uses the
+ * bit-parallel LCS, which also works when squares repeat.
+ */
+int main(int argc, char* argv[]){
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
     cout.tie(NULL);
 
+    bool bit_parallel = argc > 1 && string(argv[1]) == "bit";
+
     int rounds;
     cin >> rounds;
     for(int round = 0; round < rounds; round++){
         int squares, prince, princess;
         cin >> squares >> prince >> princess;
-        vector<int> prince_moves(prince, -1);
+        // Both start on square 1 and make prince and princess jumps
+        vector<int> prince_moves(prince + 1, -1);
         int move;
-        for(int i = 0; i < prince; i++){
+        for(int i = 0; i <= prince; i++){
             cin >> move;
-            prince_moves[i] = move;            
+            prince_moves[i] = move;
         }
 
-        vector<int> princess_moves(princess, -1);
-        for(int i = 0; i < princess; i++){
+        vector<int> princess_moves(princess + 1, -1);
+        for(int i = 0; i <= princess; i++){
             cin >> move;
             princess_moves[i] = move;
         }
 
-        // check dynamic backtracking what is best.
+        int common;
+        if(bit_parallel) {
+            common = lcs_bit_parallel(prince_moves, princess_moves);
+        } else {
+            common = lcs_distinct(prince_moves, princess_moves, squares * squares);
+        }
+        cout << "Case " << round + 1 << ": " << common << "\n";
     }
-}
\ No newline at end of file
+}
@@ -4,109 +4,405 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <string>
 using namespace std;
 
+
 struct Point {
     double x;
     double y;
 };
 
+/**
+ * @brief Vector between two points.
+ */
+struct Vec {
+    double x;
+    double y;
+};
+
+Vec operator-(Point a, Point b) {
+    return Vec{a.x - b.x, a.y - b.y};
+}
+
+double dot(Vec a, Vec b) {
+    return a.x * b.x + a.y * b.y;
+}
+
+/**
+ * @brief Squared distance between two points, distances are compared squared and sqrt is taken once.
+ */
+double squared_distance(Point a, Point b) {
+    Vec difference = a - b;
+    return dot(difference, difference);
+}
+
 struct Line {
     Point start;
     Point end;
 };
 
-struct Vec {
-    double x;
-    double y;
-};
+/**
+ * @brief Squared shortest distance from point p to line l, when the projection of p is on l.
+ *
+ * @param p
+ * @param l
+ * @return double squared distance, 0 if the projection is outside of l.
+ */
 double projectivise(Point p, Line l) {
-    //get shortest dist from point p to line l
-    Vec v1 = Vec{l.end.x - l.start.x, l.end.y - l.start.y};
-    Vec v2 = Vec{p.x - l.start.x, p.y - l.start.y};
+    Vec v1 = l.end - l.start;
+    Vec v2 = p - l.start;
 
-    double scaler = (v1.x * v2.x + v1.y * v2.y) / (v1.x * v1.x + v1.y * v1.y);
+    double scaler = dot(v1, v2) / dot(v1, v1);
     if(scaler > 1 || scaler < 0) {
         return 0;
     }
-    double x_part = (v2.x - (v1.x * scaler));
-    double y_part = (v2.y - (v1.y * scaler));
-    double dist = sqrt(x_part * x_part + y_part * y_part);
-    return dist;
+    Vec part = Vec{v2.x - (v1.x * scaler), v2.y - (v1.y * scaler)};
+    return dot(part, part);
 }
 
-int main(){
-    ios_base::sync_with_stdio(false);
-    cin.tie(NULL);
-    cout.tie(NULL);
+/**
+ * @brief The lines between every point of a polygon and the next, the last one closes the polygon.
+ *
+ * @param points Corners of the polygon in order.
+ * @return vector<Line>
+ */
+vector<Line> polygon_lines(const vector<Point>& points) {
+    vector<Line> lines;
+    for(size_t i = 1; i < points.size(); i++) {
+        lines.push_back(Line{points[i - 1], points[i]});
+    }
+    lines.push_back(Line{points.back(), points.front()});
+    return lines;
+}
 
-    int num_tests;
-    cin >> num_tests;
+/**
+ * @brief Lines stored as separate arrays (struct of arrays) so the distance loops below can be vectorized.
+ * The direction and squared length of every line are computed once.
+ */
+struct LineArrays {
+    vector<double> start_x;
+    vector<double> start_y;
+    vector<double> direction_x;
+    vector<double> direction_y;
+    vector<double> length;
 
-    while(num_tests--) {
-        vector<Point> inner_points;
-        vector<Line> inner_lines;
-        vector<Point> outer_points;
-        vector<Line> outer_lines;
-
-        int num_inner_points;
-        cin >> num_inner_points;
-        
-        // Save inner points and lines, start with point 0 outside of loop
-        double x, y;
-        cin >> x >> y;
-        inner_points.push_back(Point{x, y});
-        for(int i = 1; i < num_inner_points; i++) {
-            cin >> x >> y;
-            inner_points.push_back(Point{x, y});
-            inner_lines.push_back(Line{inner_points[i-1], inner_points[i]});
+    void add(Line l) {
+        Vec direction = l.end - l.start;
+        start_x.push_back(l.start.x);
+        start_y.push_back(l.start.y);
+        direction_x.push_back(direction.x);
+        direction_y.push_back(direction.y);
+        length.push_back(dot(direction, direction));
+    }
+
+    size_t size() const {
+        return start_x.size();
+    }
+};
+
+/**
+ * @brief Shortest squared distance from p to the lines begin to end, the same arithmetic as projectivise
+ * so the result is the same to the bit. Only lines p projects onto with a distance above 0 count, with
+ * corners the distance to the start of every line counts too. The lines are done LANES at a time with
+ * one shortest distance per lane and no branches, which the compiler turns into SIMD instructions (SSE2
+ * by default, AVX2 when it is enabled).
+ *
+ * @tparam WITH_CORNERS
+ * @param p
+ * @param lines
+ * @param begin
+ * @param end
+ * @return double squared distance, infinity if no line counts.
+ */
+template<bool WITH_CORNERS>
+double closest_lines(Point p, const LineArrays& lines, size_t begin, size_t end) {
+    constexpr int LANES = 4;
+    const double* start_x = lines.start_x.data();
+    const double* start_y = lines.start_y.data();
+    const double* direction_x = lines.direction_x.data();
+    const double* direction_y = lines.direction_y.data();
+    const double* length = lines.length.data();
+
+    double shortest[LANES];
+    for(int lane = 0; lane < LANES; lane++) {
+        shortest[lane] = numeric_limits<double>::infinity();
+    }
+    auto check_line = [&](size_t i, double& lane_shortest) {
+        double v2_x = p.x - start_x[i];
+        double v2_y = p.y - start_y[i];
+        double scaler = (direction_x[i] * v2_x + direction_y[i] * v2_y) / length[i];
+        double part_x = v2_x - (direction_x[i] * scaler);
+        double part_y = v2_y - (direction_y[i] * scaler);
+        double dist = part_x * part_x + part_y * part_y;
+        // & instead of && so there are no branches, NaN fails every comparison
+        bool projected = (scaler >= 0) & (scaler <= 1) & (dist > 0) & (dist < lane_shortest);
+        lane_shortest = projected ? dist : lane_shortest;
+        if(WITH_CORNERS) {
+            double corner = v2_x * v2_x + v2_y * v2_y;
+            lane_shortest = corner < lane_shortest ? corner : lane_shortest;
         }
-        inner_lines.push_back(Line{inner_points[num_inner_points-1], inner_points[0]});
-
-        int num_outer_points;
-        cin >> num_outer_points;
-        
-        // Save outer points and lines, start with point 0 outside of loop
-        cin >> x >> y;
-        outer_points.push_back(Point{x, y});
-        for(int i = 1; i < num_outer_points; i++) {
-            cin >> x >> y;
-            outer_points.push_back(Point{x, y});
-            outer_lines.push_back(Line{outer_points[i-1], outer_points[i]});
+    };
+
+    size_t i = begin;
+    for(; i + LANES <= end; i += LANES) {
+        for(int lane = 0; lane < LANES; lane++) {
+            check_line(i + lane, shortest[lane]);
         }
-        outer_lines.push_back(Line{outer_points[num_outer_points-1], outer_points[0]});
-
-        double shortest_dist = 1000000000;
-        // Check shortest dist from inner points to outer lines
-        for(Point p : inner_points) {
-            for(Line l : outer_lines) {
-                if(projectivise(p, l) <= 0) {
-                    continue;
-                } else {
-                    shortest_dist = min(shortest_dist, projectivise(p, l));
-                }
+    }
+    for(; i < end; i++) {
+        check_line(i, shortest[0]);
+    }
+    return min(min(shortest[0], shortest[1]), min(shortest[2], shortest[3]));
+}
+
+/**
+ * @brief Shortest squared distance from all points to all lines, see closest_lines. O(N*M).
+ *
+ * @param points
+ * @param lines
+ * @param with_corners
+ * @return double squared distance, infinity if no line counts.
+ */
+double closest_lines(const vector<Point>& points, const LineArrays& lines, bool with_corners) {
+    double shortest = numeric_limits<double>::infinity();
+    for(Point p : points) {
+        double dist = with_corners ? closest_lines<true>(p, lines, 0, lines.size())
+                                   : closest_lines<false>(p, lines, 0, lines.size());
+        shortest = min(shortest, dist);
+    }
+    return shortest;
+}
+
+/**
+ * @brief Shortest squared distance between the polygons by checking every point against every line of
+ * the other polygon, and every point against every point. O(N*M).
+ *
+ * @param inner_points
+ * @param outer_points
+ * @return double squared distance.
+ */
+double brute_force_distance(const vector<Point>& inner_points, const vector<Point>& outer_points) {
+    vector<Line> inner_lines = polygon_lines(inner_points);
+    vector<Line> outer_lines = polygon_lines(outer_points);
+    double shortest_dist = 1e18;
+    // Check shortest dist from inner points to outer lines
+    for(Point p : inner_points) {
+        for(Line l : outer_lines) {
+            double dist = projectivise(p, l);
+            if(dist > 0) {
+                shortest_dist = min(shortest_dist, dist);
             }
         }
+    }
 
-        // check shortest dist from outer points to inner lines
-        for(Point p : outer_points) {
-            for(Line l : inner_lines) {
-                if(projectivise(p, l) <= 0) {
-                    continue;
-                } else {
-                    shortest_dist = min(shortest_dist, projectivise(p, l));
-                }
+    // check shortest dist from outer points to inner lines
+    for(Point p : outer_points) {
+        for(Line l : inner_lines) {
+            double dist = projectivise(p, l);
+            if(dist > 0) {
+                shortest_dist = min(shortest_dist, dist);
             }
         }
+    }
 
-        // Check dist from inner points to outer points
-        for(Point p : inner_points) {
-            for(Point q : outer_points) {
-                double dist = sqrt((p.x - q.x) * (p.x - q.x) + (p.y - q.y) * (p.y - q.y));
-                shortest_dist = min(shortest_dist, dist);
+    // Check dist from inner points to outer points
+    for(Point p : inner_points) {
+        for(Point q : outer_points) {
+            shortest_dist = min(shortest_dist, squared_distance(p, q));
+        }
+    }
+    return shortest_dist;
+}
+
+/**
+ * @brief Bounding box tree over the lines of a polygon, to find the closest line to a point without
+ * looking at all of them. The lines are split in two halves on the longer side of their box until at
+ * most LEAF_SIZE are left, the nodes are stored as a heap (children of node k are 2k and 2k + 1).
+ */
+class LineTree {
+public:
+    static constexpr int LEAF_SIZE = 8;
+
+    /**
+     * @brief Build the tree in O(NlogN).
+     *
+     * @param points Corners of the polygon in order.
+     * @param slack Margin for rounding errors, a box is only skipped when it is further away than the
+     * shortest distance plus slack, so the result is the same as when checking every line.
+     */
+    LineTree(const vector<Point>& points, double slack) : slack(slack) {
+        vector<Line> lines = polygon_lines(points);
+        boxes.resize(4 * lines.size() + 4);
+        build(lines, 1, 0, lines.size());
+        for(Line l : lines) {
+            arrays.add(l);
+        }
+    }
+
+    /**
+     * @brief Lower shortest to the squared distance from p to the lines, counted the same way as the brute
+     * force: only lines p projects onto and with a distance above 0. With vertices it also counts the
+     * distance to the corners of the polygon (the start of every line).
+     *
+     * @param p
+     * @param with_vertices
+     * @param shortest Shortest squared distance so far, updated.
+     */
+    void closest(Point p, bool with_vertices, double& shortest) const {
+        search(1, 0, arrays.size(), p, with_vertices, shortest);
+    }
+
+private:
+    struct Box {
+        double min_x, min_y, max_x, max_y;
+    };
+
+    // Lines in the order of the leaves
+    LineArrays arrays;
+    vector<Box> boxes;
+    double slack;
+
+    /**
+     * @brief Squared distance from p to the box, 0 inside it.
+     */
+    static double box_distance(const Box& box, Point p) {
+        double dx = max(0.0, max(box.min_x - p.x, p.x - box.max_x));
+        double dy = max(0.0, max(box.min_y - p.y, p.y - box.max_y));
+        return dx * dx + dy * dy;
+    }
+
+    void build(vector<Line>& lines, int node, int begin, int end) {
+        Box& box = boxes[node];
+        box = Box{numeric_limits<double>::max(), numeric_limits<double>::max(),
+                  numeric_limits<double>::lowest(), numeric_limits<double>::lowest()};
+        for(int i = begin; i < end; i++) {
+            for(Point point : {lines[i].start, lines[i].end}) {
+                box.min_x = min(box.min_x, point.x);
+                box.min_y = min(box.min_y, point.y);
+                box.max_x = max(box.max_x, point.x);
+                box.max_y = max(box.max_y, point.y);
             }
         }
+        if(end - begin <= LEAF_SIZE) {
+            return;
+        }
+
+        // Split on the middle of the lines along the longer side
+        bool split_x = box.max_x - box.min_x >= box.max_y - box.min_y;
+        int mid = (begin + end) / 2;
+        nth_element(lines.begin() + begin, lines.begin() + mid, lines.begin() + end, [split_x](const Line& a, const Line& b) {
+            return split_x ? a.start.x + a.end.x < b.start.x + b.end.x : a.start.y + a.end.y < b.start.y + b.end.y;
+        });
+        build(lines, 2 * node, begin, mid);
+        build(lines, 2 * node + 1, mid, end);
+    }
+
+    void search(int node, int begin, int end, Point p, bool with_vertices, double& shortest) const {
+        if(box_distance(boxes[node], p) > shortest + slack) {
+            return;
+        }
+        if(end - begin <= LEAF_SIZE) {
+            double dist = with_vertices ? closest_lines<true>(p, arrays, begin, end)
+                                        : closest_lines<false>(p, arrays, begin, end);
+            shortest = min(shortest, dist);
+            return;
+        }
+
+        // Closest half first, it makes the other half more likely to be skipped
+        int mid = (begin + end) / 2;
+        if(box_distance(boxes[2 * node], p) <= box_distance(boxes[2 * node + 1], p)) {
+            search(2 * node, begin, mid, p, with_vertices, shortest);
+            search(2 * node + 1, mid, end, p, with_vertices, shortest);
+        } else {
+            search(2 * node + 1, mid, end, p, with_vertices, shortest);
+            search(2 * node, begin, mid, p, with_vertices, shortest);
+        }
+    }
+};
+
+/**
+ * @brief Shortest squared distance between the polygons with a LineTree for each polygon, the same as
+ * brute_force_distance. The inner points are checked against the outer lines and corners, and the outer
+ * points against the inner lines. Around O((N + M)log(N + M)) when the polygons are not too close.
+ *
+ * @param inner_points
+ * @param outer_points
+ * @return double squared distance.
+ */
+double tree_distance(const vector<Point>& inner_points, const vector<Point>& outer_points) {
+    // Small polygons are faster with the vectorized loops over all pairs than with building trees
+    if(inner_points.size() * outer_points.size() <= 1 << 14) {
+        LineArrays inner_lines, outer_lines;
+        for(Line l : polygon_lines(inner_points)) {
+            inner_lines.add(l);
+        }
+        for(Line l : polygon_lines(outer_points)) {
+            outer_lines.add(l);
+        }
+        return min({1e18, closest_lines(inner_points, outer_lines, true), closest_lines(outer_points, inner_lines, false)});
+    }
+
+    // Rounding errors in squared distances are around epsilon times the squared coordinates
+    double scale = 1;
+    for(const vector<Point>* points : {&inner_points, &outer_points}) {
+        for(Point p : *points) {
+            scale = max(scale, max(fabs(p.x), fabs(p.y)));
+        }
+    }
+    double slack = 1e-12 * scale * scale;
+
+    LineTree inner_tree(inner_points, slack);
+    LineTree outer_tree(outer_points, slack);
+    double shortest_dist = 1e18;
+    for(Point p : inner_points) {
+        outer_tree.closest(p, true, shortest_dist);
+    }
+    for(Point p : outer_points) {
+        inner_tree.closest(p, false, shortest_dist);
+    }
+    return shortest_dist;
+}
+
+/**
+ * @brief Read a polygon as the number of points and then the points.
+ *
+ * @return vector<Point>
+ */
+vector<Point> read_polygon() {
+    int num_points;
+    cin >> num_points;
+    vector<Point> points(num_points);
+    for(Point& point : points) {
+        cin >> point.x >> point.y;
+    }
+    return points;
+}
+
+/**
+ * @brief Half the shortest distance between the inner and outer polygon for every test. Passing "brute"
+ * as argument checks all pairs instead of using the trees.
+ */
+int main(int argc, char* argv[]){
+    ios_base::sync_with_stdio(false);
+    cin.tie(NULL);
+    cout.tie(NULL);
+
+    bool brute_force = argc > 1 && string(argv[1]) == "brute";
+
+    int num_tests;
+    cin >> num_tests;
+
+    while(num_tests--) {
+        vector<Point> inner_points = read_polygon();
+        vector<Point> outer_points = read_polygon();
+
+        // Squared distances are compared, sqrt is only taken of the shortest
+        double shortest_dist = brute_force ? brute_force_distance(inner_points, outer_points)
+                                           : tree_distance(inner_points, outer_points);
+        shortest_dist = sqrt(shortest_dist);
 
         cout << setprecision(8) << (shortest_dist/2) << "\n";
     }
-}
\ No newline at end of file
+}
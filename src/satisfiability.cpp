@@ -2,134 +2,1575 @@
 #include <vector>
 #include <algorithm>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <iterator>
 #include <utility>
-#include <map>
-#include <bitset>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <cctype>
+#include <climits>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <random>
 #include <cmath>
 using namespace std;
 
-vector<string> separate_string (string str) {
-    stringstream ss{str};
-    // Iterates over ss and puts every word into a vector<string> (through constructor)
-    return { istream_iterator<string>{ ss }, istream_iterator<string>{} };
+/**
+ * @brief Read all of standard input into one buffer, tokens are then views into this buffer.
+ *
+ * @return string with the whole input.
+ */
+string read_input() {
+    return string(istreambuf_iterator<char>(cin), istreambuf_iterator<char>());
 }
 
-int main() {
-    ios_base::sync_with_stdio(false);
-    cin.tie(NULL);
-    cout.tie(NULL);
+/**
+ * @brief Take the next line from the front of the buffer (without the newline).
+ *
+ * @param buffer Remaining input, moved forward past the line.
+ * @return string_view of the line.
+ */
+string_view next_line(string_view& buffer) {
+    size_t end = buffer.find('\n');
+    string_view line = buffer.substr(0, end);
+    buffer.remove_prefix(end == string_view::npos ? buffer.size() : end + 1);
+    return line;
+}
 
-    int tests;
-    cin >> tests;
-    for(int test = 0; test < tests; test++) {
-        int variables, clauses;
-        cin >> variables >> clauses;
-        cin.ignore();
-        //vector<pair<vector<bool>, vector<bool>>> clauses_vector(clauses, make_pair(vector<bool>(variables, false), vector<bool>(variables, false)));
-        vector<pair<bitset<20>, bitset<20>>> clauses_vector(clauses, make_pair(bitset<20>(), bitset<20>()));
-        map<string, int> variable_map;
-
-        string input;
-        int variable_number = 0;
-        for(int clause_num = 0; clause_num < clauses; clause_num++) {
-            getline(cin, input);
-            vector<string> s_clasues = separate_string(input);
-            for(string s : s_clasues) {
-                if(s == "v") {
+/**
+ * @brief Seperates a string on whitespace without copying, the views point into str.
+ *
+ * @param str
+ * @return vector<string_view> of every word in str.
+ */
+vector<string_view> tokenize(string_view str) {
+    vector<string_view> tokens;
+    size_t i = 0;
+    while(i < str.size()) {
+        while(i < str.size() && isspace((unsigned char) str[i])) {
+            i++;
+        }
+        size_t start = i;
+        while(i < str.size() && !isspace((unsigned char) str[i])) {
+            i++;
+        }
+        if(i > start) {
+            tokens.push_back(str.substr(start, i - start));
+        }
+    }
+    return tokens;
+}
+
+/**
+ * @brief Maps tokens to dense ids (0, 1, 2, ... in order of first appearance). The text of every token
+ * is copied once into large arena blocks and looked up through a flat open-addressing hash table
+ * with linear probing, so no node or string is allocated per token.
+ */
+class Interner {
+public:
+    Interner() {
+        table = vector<int>(16, -1);
+    }
+
+    /**
+     * @brief Get the id of a token, adding it if it has not been seen before.
+     *
+     * @param token
+     * @return int id of the token.
+     */
+    int intern(string_view token) {
+        uint32_t hash = hash_token(token);
+        size_t mask = table.size() - 1;
+        size_t slot = hash & mask;
+        while(table[slot] != -1) {
+            int id = table[slot];
+            if(hashes[id] == hash && tokens[id] == token) {
+                return id;
+            }
+            slot = (slot + 1) & mask;
+        }
+        int id = tokens.size();
+        tokens.push_back(store(token));
+        hashes.push_back(hash);
+        table[slot] = id;
+        // Keep the table at most half full so probes stay short
+        if(tokens.size() * 2 > table.size()) {
+            grow();
+        }
+        return id;
+    }
+
+    /**
+     * @brief Get the text of a token.
+     *
+     * @param id
+     * @return string_view of the token, valid as long as the interner.
+     */
+    string_view token(int id) const {
+        return tokens[id];
+    }
+
+    /**
+     * @brief Number of different tokens.
+     *
+     * @return int
+     */
+    int size() const {
+        return tokens.size();
+    }
+
+    /**
+     * @brief Remove all tokens but keep the allocated memory for reuse.
+     */
+    void clear() {
+        tokens.clear();
+        hashes.clear();
+        fill(table.begin(), table.end(), -1);
+        current_block = 0;
+        block_used = 0;
+    }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 1 << 16;
+    vector<unique_ptr<char[]>> blocks;
+    vector<size_t> block_sizes;
+    size_t current_block = 0;
+    size_t block_used = 0;
+    vector<string_view> tokens;
+    vector<uint32_t> hashes;
+    vector<int> table;
+
+    /**
+     * @brief FNV-1a hash of a token.
+     */
+    static uint32_t hash_token(string_view token) {
+        uint32_t hash = 2166136261u;
+        for(char c : token) {
+            hash = (hash ^ (unsigned char) c) * 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Copy a token into the arena.
+     *
+     * @param token
+     * @return string_view of the copy.
+     */
+    string_view store(string_view token) {
+        while(current_block < blocks.size() && block_used + token.size() > block_sizes[current_block]) {
+            current_block++;
+            block_used = 0;
+        }
+        if(current_block == blocks.size()) {
+            size_t size = max(BLOCK_SIZE, token.size());
+            blocks.emplace_back(new char[size]);
+            block_sizes.push_back(size);
+            block_used = 0;
+        }
+        char* text = blocks[current_block].get() + block_used;
+        memcpy(text, token.data(), token.size());
+        block_used += token.size();
+        return string_view(text, token.size());
+    }
+
+    /**
+     * @brief Double the hash table and reinsert all ids.
+     */
+    void grow() {
+        table = vector<int>(table.size() * 2, -1);
+        size_t mask = table.size() - 1;
+        for(int id = 0; id < (int) tokens.size(); id++) {
+            size_t slot = hashes[id] & mask;
+            while(table[slot] != -1) {
+                slot = (slot + 1) & mask;
+            }
+            table[slot] = id;
+        }
+    }
+};
+
+// Assignments tested at once: the lowest SLICE_VARIABLES variables take every value in the
+// SLICE_WORDS * 64 bits, every bit is one assignment.
+const int SLICE_VARIABLES = 8;
+const int SLICE_WORDS = 4;
+// Up to this many variables the bit-sliced brute force is used instead of the CDCL solver
+const int BRUTE_FORCE_VARIABLES = 24;
+
+/**
+ * @brief Test the assignments of one thread. The variables above the sliced ones are split in prefix
+ * variables, fixed to the bits of prefix, and the rest, which are gone through in Gray code order so
+ * only one variable changes per step. For every clause, the number of its literals on non-sliced
+ * variables that are true is kept, when it is 0 the clause is decided by its sliced literals (a
+ * precomputed word per clause) and otherwise it is true for all assignments in the step.
+ *
+ * @param sliced Sliced literals of each clause or:ed together, SLICE_WORDS words per clause.
+ * @param occurrences For every non-sliced variable, (clause, is_negated) of its literals.
+ * @param first_prefix First variable fixed by the thread (variables above are Gray coded below it).
+ * @param prefix Values of the prefix variables.
+ * @param found Set when some thread finds a satisfying assignment, makes all threads stop.
+ */
+void test_assignments(const vector<uint64_t>& sliced, const vector<vector<pair<int, bool>>>& occurrences,
+                      int first_prefix, uint64_t prefix, atomic<bool>& found) {
+    int clauses = sliced.size() / SLICE_WORDS;
+    int upper_variables = occurrences.size();
+    vector<int> true_count(clauses, 0);
+    vector<uint64_t> effective(sliced);
+    vector<bool> values(upper_variables, false);
+
+    auto set_value = [&](int var, bool value) {
+        values[var] = value;
+        for(const pair<int, bool>& occurrence : occurrences[var]) {
+            int c = occurrence.first;
+            // Literal turned true when the variable matches its sign
+            int change = (value != occurrence.second) ? 1 : -1;
+            true_count[c] += change;
+            bool is_true = true_count[c] > 0;
+            for(int w = 0; w < SLICE_WORDS; w++) {
+                effective[c * SLICE_WORDS + w] = is_true ? ~(uint64_t) 0 : sliced[c * SLICE_WORDS + w];
+            }
+        }
+    };
+    auto any_satisfied = [&]() {
+        uint64_t all[SLICE_WORDS];
+        for(int w = 0; w < SLICE_WORDS; w++) {
+            all[w] = ~(uint64_t) 0;
+        }
+        for(int c = 0; c < clauses; c++) {
+            for(int w = 0; w < SLICE_WORDS; w++) {
+                all[w] &= effective[c * SLICE_WORDS + w];
+            }
+        }
+        uint64_t any = 0;
+        for(int w = 0; w < SLICE_WORDS; w++) {
+            any |= all[w];
+        }
+        return any != 0;
+    };
+
+    // Start with the literals on false variables, then set the prefix
+    for(int c = 0; c < clauses; c++) {
+        for(int w = 0; w < SLICE_WORDS; w++) {
+            effective[c * SLICE_WORDS + w] = sliced[c * SLICE_WORDS + w];
+        }
+    }
+    for(int var = 0; var < upper_variables; var++) {
+        for(const pair<int, bool>& occurrence : occurrences[var]) {
+            if(occurrence.second) {
+                true_count[occurrence.first]++;
+                fill(effective.begin() + occurrence.first * SLICE_WORDS,
+                     effective.begin() + (occurrence.first + 1) * SLICE_WORDS, ~(uint64_t) 0);
+            }
+        }
+    }
+    for(int var = first_prefix; var < upper_variables; var++) {
+        if((prefix >> (var - first_prefix)) & 1) {
+            set_value(var, true);
+        }
+    }
+
+    if(any_satisfied()) {
+        found = true;
+        return;
+    }
+    uint64_t steps = (uint64_t) 1 << first_prefix;
+    for(uint64_t step = 1; step < steps && !found; step++) {
+        // Gray code, flip the variable of the lowest set bit
+        int var = __builtin_ctzll(step);
+        set_value(var, !values[var]);
+        if(any_satisfied()) {
+            found = true;
+        }
+    }
+}
+
+/**
+ * @brief Bit-sliced brute force check of every assignment, used when there are few variables.
+ * SLICE_WORDS * 64 assignments are tested per step with word operations, the rest of the variables
+ * are gone through in Gray code order and split between threads on the highest variables.
+ *
+ * @param clause_literals Literals of every clause, variable * 2 + 1 if negated.
+ * @param variables Number of variables, up to about 40.
+ * @param num_threads
+ * @return true if some assignment satisfies all clauses,
+ * @return false otherwise.
+ */
+bool brute_force_satisfiable(const vector<vector<int>>& clause_literals, int variables, int num_threads) {
+    int clauses = clause_literals.size();
+    // Word of every sliced literal, bit b of word w is assignment w * 64 + b
+    vector<uint64_t> literal_words(2 * SLICE_VARIABLES * SLICE_WORDS, 0);
+    for(int var = 0; var < SLICE_VARIABLES; var++) {
+        for(int assignment = 0; assignment < SLICE_WORDS * 64; assignment++) {
+            uint64_t bit = (uint64_t) 1 << (assignment % 64);
+            int positive = (2 * var) * SLICE_WORDS + assignment / 64;
+            int negative = (2 * var + 1) * SLICE_WORDS + assignment / 64;
+            if((assignment >> var) & 1) {
+                literal_words[positive] |= bit;
+            } else {
+                literal_words[negative] |= bit;
+            }
+        }
+    }
+
+    int upper_variables = max(variables - SLICE_VARIABLES, 0);
+    vector<uint64_t> sliced(clauses * SLICE_WORDS, 0);
+    vector<vector<pair<int, bool>>> occurrences(upper_variables);
+    for(int c = 0; c < clauses; c++) {
+        for(int literal : clause_literals[c]) {
+            int var = literal >> 1;
+            if(var < SLICE_VARIABLES) {
+                for(int w = 0; w < SLICE_WORDS; w++) {
+                    sliced[c * SLICE_WORDS + w] |= literal_words[literal * SLICE_WORDS + w];
+                }
+            } else {
+                occurrences[var - SLICE_VARIABLES].push_back({c, literal & 1});
+            }
+        }
+    }
+
+    // Every thread gets its own values of the highest prefix_variables variables
+    int prefix_variables = 0;
+    while((1 << (prefix_variables + 1)) <= num_threads && prefix_variables < upper_variables) {
+        prefix_variables++;
+    }
+    int first_prefix = upper_variables - prefix_variables;
+    atomic<bool> found(false);
+    vector<thread> threads;
+    for(uint64_t prefix = 0; prefix < ((uint64_t) 1 << prefix_variables); prefix++) {
+        threads.emplace_back(test_assignments, cref(sliced), cref(occurrences), first_prefix, prefix, ref(found));
+    }
+    for(thread& t : threads) {
+        t.join();
+    }
+    return found;
+}
+
+/**
+ * @brief Conflict driven clause learning SAT solver. Literals are variable * 2 + 1 if negated.
+ *
+ * All clauses live back to back in one int array (the arena): a clause is the position of its header
+ * (size, flags with the LBD, activity) and its literals follow right after it. Unit propagation uses two
+ * watched literals: every clause is only visited when one of its first two literals becomes false,
+ * then another non-false literal is moved up to be watched. Every watch also keeps a blocker, another
+ * literal of the clause, and when the blocker is true the clause is skipped without reading it.
+ *
+ * A conflict is analysed back to the first unique implication point and the learnt clause makes the
+ * solver jump back to the second highest level in it. Literals of the learnt clause that follow from
+ * the others through their reasons are removed (recursive minimization). Variables are picked by
+ * activity (VSIDS), bumped for taking part in conflicts and kept in a heap, with their last value
+ * reused as polarity. The search is restarted after a Luby sequence of conflicts. Every few thousand
+ * conflicts a restart first runs a short local search (walk) on the original clauses and takes the best
+ * assignment it finds as the new polarities, which finds satisfiable instances much sooner.
+ *
+ * Every learnt clause gets its LBD, the number of different decision levels in it. Every few thousand
+ * conflicts the worse half of the learnt clauses are removed, worst meaning highest LBD and then lowest
+ * activity, but clauses with LBD 2 or less ("glue" clauses) and reasons are always kept. The arena is
+ * then compacted.
+ *
+ * The solver is incremental: clauses can be added between solves and each solve can be given
+ * assumptions, all learnt clauses and variable activities are kept from one solve to the next.
+ */
+class Solver {
+public:
+    /**
+     * @brief Construct a new Solver object
+     *
+     * @param variables Number of variables.
+     */
+    Solver(int variables) {
+        ensure_variables(variables);
+    }
+
+    /**
+     * @brief Make room for at least the given number of variables, new variables are unassigned.
+     *
+     * @param variables
+     */
+    void ensure_variables(int variables) {
+        int old_variables = assigns.size();
+        if(variables <= old_variables) {
+            return;
+        }
+        watches.resize(2 * variables);
+        assigns.resize(variables, UNASSIGNED);
+        polarity.resize(variables, 1);
+        levels.resize(variables, 0);
+        reasons.resize(variables, -1);
+        activity.resize(variables, 0);
+        seen.resize(variables, 0);
+        heap_index.resize(variables, -1);
+        level_stamps.resize(variables + 1, 0);
+        for(int var = old_variables; var < variables; var++) {
+            heap_insert(var);
+        }
+    }
+
+    /**
+     * @brief Add a clause, can be done between calls to solve. Learnt clauses are kept since they
+     * still follow from the clauses.
+     *
+     * @param literals
+     * @return false if the clauses can already be seen to be unsatisfiable.
+     */
+    bool add_clause(vector<int> literals) {
+        if(!ok) {
+            return false;
+        }
+        for(int literal : literals) {
+            ensure_variables((literal >> 1) + 1);
+        }
+        // Remove duplicates and skip tautologies and clauses already true
+        sort(literals.begin(), literals.end());
+        literals.erase(unique(literals.begin(), literals.end()), literals.end());
+        vector<int> kept;
+        for(int i = 0; i < (int) literals.size(); i++) {
+            int literal = literals[i];
+            if((i > 0 && literals[i - 1] == (literal ^ 1)) || value(literal) == TRUE) {
+                return true;
+            }
+            if(i + 1 < (int) literals.size() && literals[i + 1] == (literal ^ 1)) {
+                return true;
+            }
+            if(value(literal) == UNASSIGNED) {
+                kept.push_back(literal);
+            }
+        }
+        if(kept.empty()) {
+            ok = false;
+        } else if(kept.size() == 1) {
+            enqueue(kept[0], -1);
+            ok = propagate() == -1;
+        } else {
+            attach_clause(kept, false, 0);
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Search for an assignment that satisfies all clauses and makes all assumptions true.
+     * The assumptions are decided first, one per decision level, and only hold for this call.
+     *
+     * @param assumptions Literals that must be true.
+     * @return true if satisfiable,
+     * @return false otherwise.
+     */
+    bool solve(const vector<int>& assumptions = {}) {
+        if(!ok) {
+            return false;
+        }
+        this->assumptions = assumptions;
+        for(int literal : assumptions) {
+            ensure_variables((literal >> 1) + 1);
+        }
+        int result = -1;
+        for(int restart = 0; result == -1; restart++) {
+            if(conflicts >= next_walk) {
+                walk();
+                next_walk = conflicts + WALK_INTERVAL;
+            }
+            result = search(luby(restart) * 100);
+        }
+        if(result == 1) {
+            model = assigns;
+        }
+        // Back to level 0 so clauses can be added before the next solve
+        cancel_until(0);
+        return result == 1;
+    }
+
+    /**
+     * @brief Value of a variable after solve returned true.
+     *
+     * @param var
+     * @return true if the variable is true in the found assignment.
+     */
+    bool model_value(int var) const {
+        return model[var] == TRUE;
+    }
+
+    /**
+     * @brief Number of variables.
+     *
+     * @return int
+     */
+    int num_variables() const {
+        return assigns.size();
+    }
+
+private:
+    static constexpr int8_t FALSE = 0, TRUE = 1, UNASSIGNED = 2;
+    // Clause header in the arena: size, flags (learnt, deleted and LBD from bit 2) and activity
+    static constexpr int HEADER = 3;
+    static constexpr int LEARNT = 1, DELETED = 2;
+    // Learnt clauses are reduced first after this many conflicts, then the wait grows by the increment
+    static constexpr long FIRST_REDUCE = 2000, REDUCE_INCREMENT = 300;
+    // Conflicts between walks, and flips per literal in the clauses for every walk
+    static constexpr long WALK_INTERVAL = 10000, WALK_EFFORT = 10;
+    // A variable that makes b clauses false is flipped with weight (1 + b)^-WALK_EXPONENT
+    static constexpr double WALK_EXPONENT = 2.38;
+
+    struct Watcher {
+        int clause;
+        // Another literal of the clause, if it is true the clause is satisfied
+        int blocker;
+    };
+
+    // False when the clauses are unsatisfiable without assumptions
+    bool ok = true;
+    vector<int> arena;
+    vector<int> learnts;
+    vector<int> assumptions;
+    vector<int8_t> model;
+    // Clauses watching each literal, visited when the literal becomes false
+    vector<vector<Watcher>> watches;
+    vector<int8_t> assigns;
+    vector<int8_t> polarity;
+    vector<int> levels;
+    vector<int> reasons;
+    vector<int> trail;
+    // Trail position where every decision level starts
+    vector<int> trail_limits;
+    size_t propagate_head = 0;
+
+    vector<double> activity;
+    double var_increase = 1;
+    float clause_increase = 1;
+    long conflicts = 0;
+    long next_reduce = FIRST_REDUCE;
+    long reduce_wait = FIRST_REDUCE;
+    vector<int> heap;
+    vector<int> heap_index;
+    vector<char> seen;
+    // Literals marked seen during analyze and the stack of the redundancy check
+    vector<int> to_clear;
+    vector<int> redundant_stack;
+    // Used to count the different levels in a clause
+    vector<long> level_stamps;
+    long stamp = 0;
+    long next_walk = 0;
+    mt19937 random_engine;
+
+    int8_t value(int literal) const {
+        int8_t var_value = assigns[literal >> 1];
+        return var_value == UNASSIGNED ? UNASSIGNED : var_value ^ (literal & 1);
+    }
+
+    int decision_level() const {
+        return trail_limits.size();
+    }
+
+    void enqueue(int literal, int reason) {
+        int var = literal >> 1;
+        assigns[var] = !(literal & 1);
+        levels[var] = decision_level();
+        reasons[var] = reason;
+        trail.push_back(literal);
+    }
+
+    int clause_size(int clause) const {
+        return arena[clause];
+    }
+
+    int* clause_literals(int clause) {
+        return &arena[clause + HEADER];
+    }
+
+    bool is_learnt(int clause) const {
+        return arena[clause + 1] & LEARNT;
+    }
+
+    int clause_lbd(int clause) const {
+        return arena[clause + 1] >> 2;
+    }
+
+    void set_lbd(int clause, int lbd) {
+        arena[clause + 1] = (lbd << 2) | (arena[clause + 1] & 3);
+    }
+
+    float clause_activity(int clause) const {
+        float clause_value;
+        memcpy(&clause_value, &arena[clause + 2], sizeof(float));
+        return clause_value;
+    }
+
+    void set_clause_activity(int clause, float clause_value) {
+        memcpy(&arena[clause + 2], &clause_value, sizeof(float));
+    }
+
+    int attach_clause(const vector<int>& literals, bool learnt, int lbd) {
+        int clause = arena.size();
+        arena.push_back(literals.size());
+        arena.push_back((lbd << 2) | (learnt ? LEARNT : 0));
+        arena.push_back(0);
+        arena.insert(arena.end(), literals.begin(), literals.end());
+        watches[literals[0]].push_back({clause, literals[1]});
+        watches[literals[1]].push_back({clause, literals[0]});
+        if(learnt) {
+            learnts.push_back(clause);
+        }
+        return clause;
+    }
+
+    /**
+     * @brief Number of different decision levels among the literals (LBD).
+     */
+    int compute_lbd(const int* literals, int size) {
+        stamp++;
+        int lbd = 0;
+        for(int k = 0; k < size; k++) {
+            int level = levels[literals[k] >> 1];
+            if(level_stamps[level] != stamp) {
+                level_stamps[level] = stamp;
+                lbd++;
+            }
+        }
+        return lbd;
+    }
+
+    /**
+     * @brief Propagate all enqueued literals through the watched clauses.
+     *
+     * @return int arena position of a conflicting clause, -1 if there is no conflict.
+     */
+    int propagate() {
+        int conflict = -1;
+        while(propagate_head < trail.size() && conflict == -1) {
+            int false_literal = trail[propagate_head++] ^ 1;
+            vector<Watcher>& watching = watches[false_literal];
+            Watcher* i = watching.data();
+            Watcher* j = i;
+            Watcher* end = i + watching.size();
+            while(i != end) {
+                // Satisfied by the blocker, the clause is not read at all
+                if(value(i->blocker) == TRUE) {
+                    *j++ = *i++;
+                    continue;
+                }
+                int clause = i->clause;
+                int* literals = clause_literals(clause);
+                // Keep the false literal second
+                if(literals[0] == false_literal) {
+                    swap(literals[0], literals[1]);
+                }
+                i++;
+                int first = literals[0];
+                Watcher watcher{clause, first};
+                if(value(first) == TRUE) {
+                    *j++ = watcher;
                     continue;
                 }
+                // Look for a new literal to watch
+                bool moved = false;
+                int size = clause_size(clause);
+                for(int k = 2; k < size; k++) {
+                    if(value(literals[k]) != FALSE) {
+                        literals[1] = literals[k];
+                        literals[k] = false_literal;
+                        watches[literals[1]].push_back(watcher);
+                        moved = true;
+                        break;
+                    }
+                }
+                if(moved) {
+                    continue;
+                }
+                // Clause is unit or conflicting
+                *j++ = watcher;
+                if(value(first) == FALSE) {
+                    conflict = clause;
+                    while(i != end) {
+                        *j++ = *i++;
+                    }
+                } else {
+                    enqueue(first, clause);
+                }
+            }
+            watching.resize(j - watching.data());
+        }
+        if(conflict != -1) {
+            propagate_head = trail.size();
+        }
+        return conflict;
+    }
 
-                bool is_negated = false;
-                if(s[0] == '~') {
-                    is_negated = true;
-                    s = s.substr(1);
+    /**
+     * @brief Learn a clause from a conflict, cut at the first unique implication point.
+     *
+     * @param conflict Arena position of the conflicting clause.
+     * @param learnt Set to the learnt clause, the asserting literal first.
+     * @param lbd Set to the LBD of the learnt clause.
+     * @return int decision level to jump back to.
+     */
+    int analyze(int conflict, vector<int>& learnt, int& lbd) {
+        learnt.assign(1, -1);
+        int path_count = 0;
+        int literal = -1;
+        int trail_index = trail.size() - 1;
+        do {
+            int size = clause_size(conflict);
+            int* literals = clause_literals(conflict);
+            if(is_learnt(conflict)) {
+                bump_clause(conflict);
+                // Clauses that keep being used get a better LBD when they now span fewer levels
+                if(clause_lbd(conflict) > 2) {
+                    int new_lbd = compute_lbd(literals, size);
+                    if(new_lbd < clause_lbd(conflict)) {
+                        set_lbd(conflict, new_lbd);
+                    }
                 }
+            }
+            // The first literal of a reason is the one it implied
+            for(int k = literal == -1 ? 0 : 1; k < size; k++) {
+                int other = literals[k];
+                int var = other >> 1;
+                if(!seen[var] && levels[var] > 0) {
+                    bump_var(var);
+                    seen[var] = 1;
+                    if(levels[var] >= decision_level()) {
+                        path_count++;
+                    } else {
+                        learnt.push_back(other);
+                    }
+                }
+            }
+            // Next literal of the current level on the trail
+            while(!seen[trail[trail_index] >> 1]) {
+                trail_index--;
+            }
+            literal = trail[trail_index--];
+            conflict = reasons[literal >> 1];
+            seen[literal >> 1] = 0;
+            path_count--;
+        } while(path_count > 0);
+        learnt[0] = literal ^ 1;
 
+        // Remove literals that follow from the other literals in the clause through their reasons
+        to_clear.assign(learnt.begin() + 1, learnt.end());
+        uint32_t abstract_levels = 0;
+        for(size_t i = 1; i < learnt.size(); i++) {
+            abstract_levels |= abstract_level(learnt[i] >> 1);
+        }
+        size_t kept = 1;
+        for(size_t i = 1; i < learnt.size(); i++) {
+            if(reasons[learnt[i] >> 1] == -1 || !literal_redundant(learnt[i], abstract_levels)) {
+                learnt[kept++] = learnt[i];
+            }
+        }
+        learnt.resize(kept);
+        for(int other : to_clear) {
+            seen[other >> 1] = 0;
+        }
 
-                if(variable_map.find(s) == variable_map.end()) {
-                    variable_map[s] = variable_number;
-                    variable_number++;
-                }
+        // Second watch is the literal with highest level, which is where to jump back to
+        int back_level = 0;
+        for(size_t i = 1; i < learnt.size(); i++) {
+            if(levels[learnt[i] >> 1] > levels[learnt[1] >> 1]) {
+                swap(learnt[1], learnt[i]);
+            }
+        }
+        if(learnt.size() > 1) {
+            back_level = levels[learnt[1] >> 1];
+        }
+        lbd = compute_lbd(learnt.data(), learnt.size());
+        return back_level;
+    }
 
-                // for(auto p : variable_map) {
-                //     cout << p.first << " " << p.second << endl;
-                // }
+    /**
+     * @brief One bit per decision level (modulo 32), a quick test if a level can be in the learnt clause.
+     */
+    uint32_t abstract_level(int var) const {
+        return 1u << (levels[var] & 31);
+    }
 
-                int var_num = variable_map[s];
-                // cout << "var_num: " << s << " "<< var_num << endl;
+    /**
+     * @brief Check if a literal of the learnt clause is implied by the other literals, by following its
+     * reasons back until only seen literals are left. Gives up on a decision or on a level that is not
+     * in the clause. Literals found to be implied stay seen so they are not checked again.
+     *
+     * @param literal
+     * @param abstract_levels Abstract levels of the learnt clause.
+     * @return true if the literal can be removed.
+     */
+    bool literal_redundant(int literal, uint32_t abstract_levels) {
+        redundant_stack.assign(1, literal);
+        size_t top = to_clear.size();
+        while(!redundant_stack.empty()) {
+            int reason = reasons[redundant_stack.back() >> 1];
+            redundant_stack.pop_back();
+            int size = clause_size(reason);
+            int* literals = clause_literals(reason);
+            for(int k = 1; k < size; k++) {
+                int other = literals[k];
+                int var = other >> 1;
+                if(seen[var] || levels[var] == 0) {
+                    continue;
+                }
+                if(reasons[var] != -1 && (abstract_level(var) & abstract_levels) != 0) {
+                    seen[var] = 1;
+                    redundant_stack.push_back(other);
+                    to_clear.push_back(other);
+                } else {
+                    for(size_t i = top; i < to_clear.size(); i++) {
+                        seen[to_clear[i] >> 1] = 0;
+                    }
+                    to_clear.resize(top);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
 
-                // if(is_negated) {
-                //     clauses_vector[clause_num].second[var_num] = true;
-                // } else {
-                //     clauses_vector[clause_num].first[var_num] = true;
-                // }
+    /**
+     * @brief Undo all assignments above level.
+     *
+     * @param level
+     */
+    void cancel_until(int level) {
+        if(decision_level() <= level) {
+            return;
+        }
+        for(int i = trail.size() - 1; i >= trail_limits[level]; i--) {
+            int var = trail[i] >> 1;
+            polarity[var] = assigns[var];
+            assigns[var] = UNASSIGNED;
+            reasons[var] = -1;
+            if(heap_index[var] == -1) {
+                heap_insert(var);
+            }
+        }
+        trail.resize(trail_limits[level]);
+        trail_limits.resize(level);
+        propagate_head = trail.size();
+    }
 
-                if(is_negated) {
-                    clauses_vector[clause_num].second.set(var_num);
+    /**
+     * @brief Search until a result or until the number of conflicts runs out.
+     *
+     * @param max_conflicts
+     * @return int 1 if satisfiable, 0 if unsatisfiable and -1 if it should restart.
+     */
+    int search(long max_conflicts) {
+        long search_conflicts = 0;
+        vector<int> learnt;
+        while(true) {
+            int conflict = propagate();
+            if(conflict != -1) {
+                conflicts++;
+                search_conflicts++;
+                if(decision_level() == 0) {
+                    ok = false;
+                    return 0;
+                }
+                int lbd;
+                int back_level = analyze(conflict, learnt, lbd);
+                cancel_until(back_level);
+                if(learnt.size() == 1) {
+                    enqueue(learnt[0], -1);
                 } else {
-                    clauses_vector[clause_num].first.set(var_num);
-                }
-
-                // if(clauses_vector[clause_num].first[var_num] && clauses_vector[clause_num].second[var_num]) {
-                //     // Set alla variables to true when a tautology is found
-                //     for(int i = 0; i < variables; i++) {
-                //         clauses_vector[clause_num].first[i] = true;
-                //         clauses_vector[clause_num].second[i] = true;
-                //     }
-                //     break;
-                // }
-
-                if(clauses_vector[clause_num].first.test(var_num) && clauses_vector[clause_num].second.test(var_num)) {
-                    // Set alla variables to true when a tautology is found
-                    clauses_vector[clause_num].first.set();
-                    clauses_vector[clause_num].second.set();
+                    int clause = attach_clause(learnt, true, lbd);
+                    bump_clause(clause);
+                    enqueue(learnt[0], clause);
+                }
+                var_increase /= 0.95;
+                clause_increase /= 0.999;
+                continue;
+            }
+
+            if(search_conflicts >= max_conflicts) {
+                cancel_until(0);
+                return -1;
+            }
+            if(conflicts >= next_reduce) {
+                reduce_wait += REDUCE_INCREMENT;
+                next_reduce = conflicts + reduce_wait;
+                reduce_learnts();
+            }
+            // Assumptions are the first decisions
+            int decision = -1;
+            while(decision_level() < (int) assumptions.size()) {
+                int assumption = assumptions[decision_level()];
+                if(value(assumption) == TRUE) {
+                    // Already true, an empty level keeps levels and assumptions in step
+                    trail_limits.push_back(trail.size());
+                } else if(value(assumption) == FALSE) {
+                    return 0;
+                } else {
+                    decision = assumption;
                     break;
                 }
+            }
+            if(decision == -1) {
+                int var = pick_branch_var();
+                if(var == -1) {
+                    return 1;
+                }
+                decision = 2 * var + !polarity[var];
+            }
+            trail_limits.push_back(trail.size());
+            enqueue(decision, -1);
+        }
+    }
 
-            } 
+    /**
+     * @brief Remove the worse half of the learnt clauses, keeping glue clauses, binary clauses and reasons,
+     * then compact the arena.
+     */
+    void reduce_learnts() {
+        sort(learnts.begin(), learnts.end(), [&](int a, int b) {
+            if(clause_lbd(a) != clause_lbd(b)) {
+                return clause_lbd(a) > clause_lbd(b);
+            }
+            return clause_activity(a) < clause_activity(b);
+        });
+        for(size_t i = 0; i < learnts.size() / 2; i++) {
+            int clause = learnts[i];
+            int first = clause_literals(clause)[0];
+            bool locked = reasons[first >> 1] == clause && value(first) == TRUE;
+            if(clause_lbd(clause) > 2 && clause_size(clause) > 2 && !locked) {
+                arena[clause + 1] |= DELETED;
+            }
         }
-        bool satisfiable = false;
-        // check if satisfiable trugh brute force
+        compact_arena();
+    }
 
-        // int i=0;
-        // for(auto p : clauses_vector) {
-        //     cout << i << " " << p.first << " " << p.second << endl;
-        //     i++;
-        // }
+    /**
+     * @brief Move all clauses that are not deleted to the front of a new arena and point the watches,
+     * reasons and learnt clauses to the new positions. The old position of a moved clause holds its new
+     * position while this is done.
+     */
+    void compact_arena() {
+        vector<int> new_arena;
+        new_arena.reserve(arena.size());
+        for(size_t clause = 0; clause < arena.size(); clause += HEADER + arena[clause]) {
+            if(arena[clause + 1] & DELETED) {
+                continue;
+            }
+            int moved_to = new_arena.size();
+            new_arena.insert(new_arena.end(), arena.begin() + clause, arena.begin() + clause + HEADER + arena[clause]);
+            arena[clause + 2] = moved_to;
+        }
+        auto is_deleted = [&](int clause) {
+            return (arena[clause + 1] & DELETED) != 0;
+        };
+        for(vector<Watcher>& watching : watches) {
+            size_t kept = 0;
+            for(Watcher watcher : watching) {
+                if(!is_deleted(watcher.clause)) {
+                    watching[kept++] = {arena[watcher.clause + 2], watcher.blocker};
+                }
+            }
+            watching.resize(kept);
+        }
+        for(int literal : trail) {
+            int& reason = reasons[literal >> 1];
+            if(reason != -1) {
+                reason = arena[reason + 2];
+            }
+        }
+        size_t kept = 0;
+        for(int clause : learnts) {
+            if(!is_deleted(clause)) {
+                learnts[kept++] = arena[clause + 2];
+            }
+        }
+        learnts.resize(kept);
+        arena.swap(new_arena);
+    }
 
+    /**
+     * @brief Local search (probSAT) on the original clauses, starting from the polarities. A random false
+     * clause is picked and one of its variables is flipped, picked with weight (1 + b)^-WALK_EXPONENT
+     * where b is the number of clauses the flip makes false. Only done at level 0, variables assigned
+     * there are kept. The best assignment found becomes the new polarities.
+     */
+    void walk() {
+        int variables = assigns.size();
+        // Clauses not already true at level 0
+        vector<int> walk_clauses;
+        long literal_count = 0;
+        for(size_t clause = 0; clause < arena.size(); clause += HEADER + arena[clause]) {
+            if(is_learnt(clause)) {
+                continue;
+            }
+            int* literals = clause_literals(clause);
+            bool satisfied = false;
+            for(int k = 0; k < clause_size(clause); k++) {
+                satisfied |= value(literals[k]) == TRUE;
+            }
+            if(!satisfied) {
+                walk_clauses.push_back(clause);
+                literal_count += clause_size(clause);
+            }
+        }
+        if(walk_clauses.empty()) {
+            return;
+        }
 
-        for(int i = 0; i < pow(2, variables); i++) {
-            for(int c = 0; c < clauses; c++) {
-                bitset<20> bits(i);
-                bitset<20> and_bits(i);
-                bitset<20> neg_and_bits(i);
-                neg_and_bits.flip();
-                and_bits &= clauses_vector[c].first;
-                neg_and_bits &= clauses_vector[c].second;
+        // Clauses of every unassigned literal, grouped per literal
+        vector<int> occurrence_start(2 * variables + 1, 0);
+        for(int clause : walk_clauses) {
+            int* literals = clause_literals(clause);
+            for(int k = 0; k < clause_size(clause); k++) {
+                if(value(literals[k]) == UNASSIGNED) {
+                    occurrence_start[literals[k] + 1]++;
+                }
+            }
+        }
+        for(int literal = 0; literal < 2 * variables; literal++) {
+            occurrence_start[literal + 1] += occurrence_start[literal];
+        }
+        vector<int> occurrences(occurrence_start.back());
+        vector<int> fill_pos(occurrence_start.begin(), occurrence_start.end() - 1);
+        for(int i = 0; i < (int) walk_clauses.size(); i++) {
+            int* literals = clause_literals(walk_clauses[i]);
+            for(int k = 0; k < clause_size(walk_clauses[i]); k++) {
+                if(value(literals[k]) == UNASSIGNED) {
+                    occurrences[fill_pos[literals[k]]++] = i;
+                }
+            }
+        }
 
-                //cout <<  i << " bits: " << bits << endl;
-                // cout << "and_bits: " << and_bits << endl;
-                // cout << "neg_and_bits: " << neg_and_bits << endl;
+        // Start from the polarities, with the number of true literals in every clause and the false clauses
+        vector<int8_t> walk_value(polarity);
+        auto is_true = [&](int literal) {
+            return (walk_value[literal >> 1] ^ (literal & 1)) == TRUE;
+        };
+        vector<int> true_count(walk_clauses.size(), 0);
+        vector<int> false_clauses;
+        vector<int> false_pos(walk_clauses.size(), -1);
+        for(int i = 0; i < (int) walk_clauses.size(); i++) {
+            int* literals = clause_literals(walk_clauses[i]);
+            for(int k = 0; k < clause_size(walk_clauses[i]); k++) {
+                true_count[i] += value(literals[k]) == UNASSIGNED && is_true(literals[k]);
+            }
+            if(true_count[i] == 0) {
+                false_pos[i] = false_clauses.size();
+                false_clauses.push_back(i);
+            }
+        }
 
-                if(and_bits.any() || neg_and_bits.any()) {
-                    // cout << "came here1" << endl;
-                    satisfiable = true;
+        double break_weights[64];
+        for(int b = 0; b < 64; b++) {
+            break_weights[b] = pow(1.0 + b, -WALK_EXPONENT);
+        }
+        // Flips since the best assignment, undone at the end
+        vector<int> flips_since_best;
+        size_t best_false = false_clauses.size();
+        vector<int> candidates;
+        vector<double> weights;
+        for(long flips = 0; flips < WALK_EFFORT * literal_count && !false_clauses.empty(); flips++) {
+            int clause = walk_clauses[false_clauses[random_engine() % false_clauses.size()]];
+            int* literals = clause_literals(clause);
+            candidates.clear();
+            weights.clear();
+            double total = 0;
+            for(int k = 0; k < clause_size(clause); k++) {
+                int literal = literals[k];
+                if(value(literal) != UNASSIGNED) {
                     continue;
-                } else {
-                    // cout << "came here2" << endl;
-                    satisfiable = false;
-                    break;
                 }
+                // Clauses where the negation is the only true literal become false
+                int breaks = 0;
+                for(int i = occurrence_start[literal ^ 1]; i < occurrence_start[(literal ^ 1) + 1]; i++) {
+                    breaks += true_count[occurrences[i]] == 1;
+                }
+                candidates.push_back(literal);
+                weights.push_back(break_weights[min(breaks, 63)]);
+                total += weights.back();
             }
-            if(satisfiable) {
+            double pick = uniform_real_distribution<double>(0, total)(random_engine);
+            size_t chosen = 0;
+            while(chosen + 1 < candidates.size() && pick >= weights[chosen]) {
+                pick -= weights[chosen++];
+            }
+
+            int literal = candidates[chosen];
+            walk_value[literal >> 1] ^= 1;
+            for(int i = occurrence_start[literal]; i < occurrence_start[literal + 1]; i++) {
+                int made_true = occurrences[i];
+                if(true_count[made_true]++ == 0) {
+                    int last = false_clauses.back();
+                    false_clauses[false_pos[made_true]] = last;
+                    false_pos[last] = false_pos[made_true];
+                    false_clauses.pop_back();
+                    false_pos[made_true] = -1;
+                }
+            }
+            for(int i = occurrence_start[literal ^ 1]; i < occurrence_start[(literal ^ 1) + 1]; i++) {
+                int made_false = occurrences[i];
+                if(--true_count[made_false] == 0) {
+                    false_pos[made_false] = false_clauses.size();
+                    false_clauses.push_back(made_false);
+                }
+            }
+            flips_since_best.push_back(literal >> 1);
+            if(false_clauses.size() < best_false) {
+                best_false = false_clauses.size();
+                flips_since_best.clear();
+            }
+        }
+        for(int var : flips_since_best) {
+            walk_value[var] ^= 1;
+        }
+        for(int var = 0; var < variables; var++) {
+            if(assigns[var] == UNASSIGNED) {
+                polarity[var] = walk_value[var];
+            }
+        }
+    }
+
+    void bump_var(int var) {
+        activity[var] += var_increase;
+        if(activity[var] > 1e100) {
+            // Rescale everything to avoid overflow
+            for(double& a : activity) {
+                a *= 1e-100;
+            }
+            var_increase *= 1e-100;
+        }
+        if(heap_index[var] != -1) {
+            heap_up(heap_index[var]);
+        }
+    }
+
+    void bump_clause(int clause) {
+        set_clause_activity(clause, clause_activity(clause) + clause_increase);
+        if(clause_activity(clause) > 1e20) {
+            for(int learnt : learnts) {
+                set_clause_activity(learnt, clause_activity(learnt) * 1e-20);
+            }
+            clause_increase *= 1e-20;
+        }
+    }
+
+    int pick_branch_var() {
+        while(!heap.empty()) {
+            int var = heap_pop();
+            if(assigns[var] == UNASSIGNED) {
+                return var;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Luby sequence 1, 1, 2, 1, 1, 2, 4, 1, ... used for restart lengths.
+     */
+    static long luby(int i) {
+        long size = 1;
+        int seq = 0;
+        while(size < i + 1) {
+            seq++;
+            size = 2 * size + 1;
+        }
+        while(size - 1 != i) {
+            size = (size - 1) / 2;
+            seq--;
+            i = i % size;
+        }
+        return 1L << seq;
+    }
+
+    // Binary max heap of variables on activity
+    void heap_insert(int var) {
+        heap_index[var] = heap.size();
+        heap.push_back(var);
+        heap_up(heap.size() - 1);
+    }
+
+    int heap_pop() {
+        int top = heap[0];
+        heap_index[top] = -1;
+        heap[0] = heap.back();
+        heap.pop_back();
+        if(!heap.empty()) {
+            heap_index[heap[0]] = 0;
+            heap_down(0);
+        }
+        return top;
+    }
+
+    void heap_up(int i) {
+        int var = heap[i];
+        while(i > 0 && activity[heap[(i - 1) / 2]] < activity[var]) {
+            heap[i] = heap[(i - 1) / 2];
+            heap_index[heap[i]] = i;
+            i = (i - 1) / 2;
+        }
+        heap[i] = var;
+        heap_index[var] = i;
+    }
+
+    void heap_down(int i) {
+        int var = heap[i];
+        int size = heap.size();
+        while(2 * i + 1 < size) {
+            int child = 2 * i + 1;
+            if(child + 1 < size && activity[heap[child + 1]] > activity[heap[child]]) {
+                child++;
+            }
+            if(activity[heap[child]] <= activity[var]) {
                 break;
             }
+            heap[i] = heap[child];
+            heap_index[heap[i]] = i;
+            i = child;
+        }
+        heap[i] = var;
+        heap_index[var] = i;
+    }
+};
+
+/**
+ * @brief Solve a 2-CNF (every clause has at most two literals) in O(N + M). Clause (a v b) gives the
+ * implications ~a -> b and ~b -> a, a unit clause (a) gives ~a -> a. The strongly connected components
+ * of the implication graph (stored as arrays of edges per literal) are found with an iterative Tarjan,
+ * the clauses are unsatisfiable exactly when a variable and its negation are in the same component.
+ * Tarjan finds the components in reverse topological order, so a literal is set true when its
+ * component was found before the component of its negation.
+ *
+ * @param clause_literals Literals of every clause, variable * 2 + 1 if negated.
+ * @param variables Number of variables.
+ * @param assignment Set to a satisfying value of every variable.
+ * @return true if satisfiable,
+ * @return false otherwise.
+ */
+bool two_sat(const vector<vector<int>>& clause_literals, int variables, vector<bool>& assignment) {
+    int nodes = 2 * variables;
+    // Implication edges grouped per literal
+    vector<int> edge_start(nodes + 1, 0);
+    for(const vector<int>& clause : clause_literals) {
+        if(clause.empty()) {
+            return false;
+        }
+        edge_start[clause[0] ^ 1]++;
+        if(clause.size() == 2) {
+            edge_start[clause[1] ^ 1]++;
+        }
+    }
+    for(int node = 0; node < nodes; node++) {
+        edge_start[node + 1] += edge_start[node];
+    }
+    vector<int> edges(edge_start[nodes]);
+    for(const vector<int>& clause : clause_literals) {
+        int a = clause[0];
+        int b = clause.size() == 2 ? clause[1] : clause[0];
+        edges[--edge_start[a ^ 1]] = b;
+        if(clause.size() == 2) {
+            edges[--edge_start[b ^ 1]] = a;
+        }
+    }
+
+    vector<int> index(nodes, -1), low_link(nodes, 0), component(nodes, -1);
+    vector<int> stack, call_stack, next_edge(nodes, 0);
+    int counter = 0, components = 0;
+    for(int root = 0; root < nodes; root++) {
+        if(index[root] != -1) {
+            continue;
+        }
+        // Depth first search with an explicit call stack
+        call_stack.push_back(root);
+        while(!call_stack.empty()) {
+            int node = call_stack.back();
+            if(index[node] == -1) {
+                index[node] = low_link[node] = counter++;
+                next_edge[node] = edge_start[node];
+                stack.push_back(node);
+            }
+            if(next_edge[node] < edge_start[node + 1]) {
+                int next = edges[next_edge[node]++];
+                if(index[next] == -1) {
+                    call_stack.push_back(next);
+                } else if(component[next] == -1) {
+                    low_link[node] = min(low_link[node], index[next]);
+                }
+                continue;
+            }
+            // All edges done, node is the root of a component if nothing below reached higher
+            call_stack.pop_back();
+            if(!call_stack.empty()) {
+                int parent = call_stack.back();
+                low_link[parent] = min(low_link[parent], low_link[node]);
+            }
+            if(low_link[node] == index[node]) {
+                int member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    component[member] = components;
+                } while(member != node);
+                components++;
+            }
+        }
+    }
+
+    assignment.assign(variables, false);
+    for(int var = 0; var < variables; var++) {
+        if(component[2 * var] == component[2 * var + 1]) {
+            return false;
+        }
+        assignment[var] = component[2 * var] < component[2 * var + 1];
+    }
+    return true;
+}
+
+/**
+ * @brief Read an integer straight from the buffer, skipping whitespace before it. The whole token is
+ * always skipped, also when it is not an integer.
+ *
+ * @param buffer Input buffer.
+ * @param pos Position in buffer, moved past the token.
+ * @param number Set to the integer.
+ * @return true if an integer was read,
+ * @return false at the end of the buffer or if the token is not an integer.
+ */
+bool read_int(string_view buffer, size_t& pos, long& number) {
+    while(pos < buffer.size() && isspace((unsigned char) buffer[pos])) {
+        pos++;
+    }
+    bool negative = pos < buffer.size() && buffer[pos] == '-';
+    if(negative) {
+        pos++;
+    }
+    number = 0;
+    bool has_digits = false;
+    while(pos < buffer.size() && isdigit((unsigned char) buffer[pos])) {
+        number = number * 10 + (buffer[pos] - '0');
+        has_digits = true;
+        pos++;
+    }
+    bool is_integer = has_digits && (pos == buffer.size() || isspace((unsigned char) buffer[pos]));
+    while(pos < buffer.size() && !isspace((unsigned char) buffer[pos])) {
+        pos++;
+    }
+    if(negative) {
+        number = -number;
+    }
+    return is_integer;
+}
+
+/**
+ * @brief Convert a DIMACS literal (1-based variable, negative if negated) to a solver literal.
+ */
+int from_dimacs(long literal) {
+    return literal > 0 ? 2 * (literal - 1) : 2 * (-literal - 1) + 1;
+}
+
+/**
+ * @brief Convert a solver literal to a DIMACS literal.
+ */
+long to_dimacs(int literal) {
+    return (literal & 1) ? -((literal >> 1) + 1) : (literal >> 1) + 1;
+}
+
+/**
+ * @brief Write clauses in DIMACS CNF format.
+ *
+ * @param clause_literals Literals of every clause, variable * 2 + 1 if negated.
+ * @param variables Number of variables.
+ * @return string with the CNF.
+ */
+string write_dimacs(const vector<vector<int>>& clause_literals, int variables) {
+    string output = "p cnf " + to_string(variables) + " " + to_string(clause_literals.size()) + "\n";
+    for(const vector<int>& clause : clause_literals) {
+        for(int literal : clause) {
+            output += to_string(to_dimacs(literal));
+            output += ' ';
+        }
+        output += "0\n";
+    }
+    return output;
+}
+
+/**
+ * @brief Solve a DIMACS CNF read straight from the buffer, without copying any tokens.
+ * Lines starting with 'c' are comments and the 'p' line is only used as a size hint. Clauses end with 0
+ * and can span lines. A '%' ends the input, as in the SATLIB benchmark files. As in the incremental (inccnf) format, a line "a <literals> 0" solves the clauses
+ * read so far under the given assumptions, keeping the solver state for the clauses that follow.
+ * Without any 'a' line everything is solved once at the end. Every result is printed as an
+ * "s SATISFIABLE" line with a "v ... 0" model line, or "s UNSATISFIABLE".
+ *
+ * @param buffer The whole input.
+ * @return true if done,
+ * @return false if the 'p' line is not "p cnf <variables> <clauses>" or the input has something that is not
+ * a literal where a clause should be.
+ */
+bool solve_dimacs(string_view buffer) {
+    Solver solver(0);
+    vector<int> literals;
+    bool solved = false;
+    size_t pos = 0;
+    auto print_result = [&](bool satisfiable) {
+        if(!satisfiable) {
+            cout << "s UNSATISFIABLE\n";
+            return;
+        }
+        string model = "s SATISFIABLE\nv";
+        for(int var = 0; var < solver.num_variables(); var++) {
+            model += ' ';
+            model += to_string(solver.model_value(var) ? var + 1 : -(var + 1));
+        }
+        model += " 0\n";
+        cout << model;
+    };
+
+    while(true) {
+        while(pos < buffer.size() && isspace((unsigned char) buffer[pos])) {
+            pos++;
+        }
+        if(pos == buffer.size() || buffer[pos] == '%') {
+            break;
+        }
+        char first = buffer[pos];
+        if(first == 'c' || first == 'p') {
+            if(first == 'p') {
+                // p cnf <variables> <clauses>
+                string_view line = buffer.substr(pos, buffer.find('\n', pos) - pos);
+                vector<string_view> header = tokenize(line);
+                long counts[2];
+                bool valid = header.size() == 4 && header[1] == "cnf";
+                for(int k = 0; k < 2 && valid; k++) {
+                    size_t token_pos = 0;
+                    // Literals are variable * 2 + 1 in an int
+                    valid = read_int(header[2 + k], token_pos, counts[k]) && counts[k] >= 0 && counts[k] <= INT_MAX / 2;
+                }
+                if(!valid) {
+                    cerr << "Bad DIMACS header \"" << line << "\"\n";
+                    return false;
+                }
+                solver.ensure_variables(counts[0]);
+            }
+            size_t end = buffer.find('\n', pos);
+            pos = end == string_view::npos ? buffer.size() : end;
+            continue;
+        }
+
+        bool is_assumptions = first == 'a';
+        if(is_assumptions) {
+            pos++;
+        }
+        long literal;
+        literals.clear();
+        while(true) {
+            while(pos < buffer.size() && isspace((unsigned char) buffer[pos])) {
+                pos++;
+            }
+            // A clause without its 0 at the end of the input still counts
+            if(pos == buffer.size() || buffer[pos] == '%') {
+                break;
+            }
+            size_t start = pos;
+            if(!read_int(buffer, pos, literal)) {
+                cerr << "Bad DIMACS literal \"" << buffer.substr(start, pos - start) << "\"\n";
+                return false;
+            }
+            if(literal == 0) {
+                break;
+            }
+            literals.push_back(from_dimacs(literal));
+        }
+        if(is_assumptions) {
+            print_result(solver.solve(literals));
+            solved = true;
+        } else {
+            solver.add_clause(literals);
+        }
+    }
+    if(!solved) {
+        print_result(solver.solve());
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    ios_base::sync_with_stdio(false);
+    cin.tie(NULL);
+    cout.tie(NULL);
+
+    // "dimacs" reads DIMACS CNF instead, "to-dimacs" writes every test as DIMACS CNF and
+    // "model" also prints the true literals of a satisfying assignment
+    string mode = argc > 1 ? argv[1] : "";
+    bool print_model = mode == "model";
+    string input = read_input();
+    string_view buffer = input;
+    if(mode == "dimacs") {
+        return solve_dimacs(buffer) ? 0 : 1;
+    }
+
+    vector<string_view> tokens = tokenize(next_line(buffer));
+    int tests = stoi(string(tokens[0]));
+    Interner variable_map;
+    for(int test = 0; test < tests; test++) {
+        tokens = tokenize(next_line(buffer));
+        int clauses = stoi(string(tokens[1]));
+        variable_map.clear();
+
+        // Literals of every clause, variable * 2 + 1 if negated
+        vector<vector<int>> clause_literals(clauses);
+        for(int clause_num = 0; clause_num < clauses; clause_num++) {
+            vector<string_view> s_clasues = tokenize(next_line(buffer));
+            for(string_view s : s_clasues) {
+                if(s == "v") {
+                    continue;
+                }
+
+                bool is_negated = false;
+                if(s[0] == '~') {
+                    is_negated = true;
+                    s.remove_prefix(1);
+                }
+
+                // Variables get numbers in order of first appearance
+                int var_num = variable_map.intern(s);
+                clause_literals[clause_num].push_back(2 * var_num + is_negated);
+            }
+        }
+
+        int variables = variable_map.size();
+        if(mode == "to-dimacs") {
+            cout << "c test " << test + 1 << "\n" << write_dimacs(clause_literals, variables);
+            continue;
+        }
+        bool is_two_cnf = all_of(clause_literals.begin(), clause_literals.end(), [](const vector<int>& clause) {
+            return clause.size() <= 2;
+        });
+        bool satisfiable;
+        vector<bool> assignment;
+        if(is_two_cnf) {
+            satisfiable = two_sat(clause_literals, variables, assignment);
+        } else if(variables <= BRUTE_FORCE_VARIABLES && !print_model) {
+            satisfiable = brute_force_satisfiable(clause_literals, variables, max(1u, thread::hardware_concurrency()));
+        } else {
+            Solver solver(variables);
+            for(const vector<int>& clause : clause_literals) {
+                solver.add_clause(clause);
+            }
+            satisfiable = solver.solve();
+            if(satisfiable) {
+                for(int var = 0; var < variables; var++) {
+                    assignment.push_back(solver.model_value(var));
+                }
+            }
         }
 
         if(satisfiable) {
             cout << "satisfiable\n";
+            if(print_model) {
+                string model;
+                for(int var = 0; var < variables; var++) {
+                    if(var > 0) {
+                        model += ' ';
+                    }
+                    if(!assignment[var]) {
+                        model += '~';
+                    }
+                    model += variable_map.token(var);
+                }
+                cout << model << "\n";
+            }
         } else {
             cout << "unsatisfiable\n";
         }
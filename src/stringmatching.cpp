@@ -5,6 +5,13 @@
  * The time complexity of the whole algorithm is O(n + m) where n is the size of the text and m is the size of the pattern.
  * O(m) is the time complexity of the pre_process function and O(n) for the search.
  * The space complexity of the algorithm is O(m) where m is the size of the pattern.
+ *
+ * Approximate matching is also supported with the same input format, selected by program arguments:
+ *   stringmatching hamming K  -> start positions where the pattern matches with at most K mismatches.
+ *   stringmatching edit K     -> end positions where the pattern matches with edit distance at most K.
+ * Each match is printed as position:distance. Both modes are bit-parallel and store the pattern as
+ * 64-bit words, so patterns up to 64 characters use a single word and longer patterns use ceil(m/64) words.
+ * Hamming (Shift-Or with K+1 state vectors) runs in O(n * K * ceil(m/64)) and edit (Myers) in O(n * ceil(m/64)).
  * @version 0.1
  * @date 2024-03-26 
  */
@@ -12,8 +19,12 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <cstdint>
+#include <cstdlib>
 using namespace std;
 
+const int WORD_BITS = 64;
+
 /**
  * @brief Create a longest proper prefix suffix array.
  * 
@@ -78,19 +89,187 @@ vector<int> find_maches(string pattern, string text) {
     return matches;
 }
 
-int main(){
+/**
+ * @brief Create a bitmask per character telling where in the pattern the character occurs.
+ * Bit i (in word i / 64) is set when pattern[i] == c.
+ * 
+ * @param pattern 
+ * @param words Number of 64-bit words used per mask.
+ * @return vector<uint64_t> of 256 * words masks, masks of character c start at c * words.
+ */
+vector<uint64_t> char_masks(const string& pattern, int words) {
+    vector<uint64_t> masks(256 * words, 0);
+    for(int i = 0; i < (int) pattern.size(); i++) {
+        unsigned char c = pattern[i];
+        masks[c * words + i / WORD_BITS] |= (uint64_t) 1 << (i % WORD_BITS);
+    }
+    return masks;
+}
+
+/**
+ * @brief Find all start positions where the pattern matches the text with at most k mismatches
+ * (hamming distance) using Shift-Or. State vector D[j] has bit i cleared when pattern[0..i] matches
+ * the text ending at the current character with at most j mismatches.
+ * 
+ * @param pattern 
+ * @param text 
+ * @param k Maximum number of mismatches.
+ * @return vector<pair<int, int>> of (start position, number of mismatches) for every match.
+ */
+vector<pair<int, int>> find_mismatch_maches(const string& pattern, const string& text, int k) {
+    vector<pair<int, int>> matches{};
+    int pattern_size = pattern.size();
+    if(pattern_size == 0) {
+        return matches;
+    }
+    k = min(k, pattern_size);
+    int words = (pattern_size + WORD_BITS - 1) / WORD_BITS;
+    // Masks are inverted for Shift-Or, a cleared bit means the character matches
+    vector<uint64_t> masks = char_masks(pattern, words);
+    for(uint64_t& mask : masks) {
+        mask = ~mask;
+    }
+    int last_word = (pattern_size - 1) / WORD_BITS;
+    uint64_t last_bit = (uint64_t) 1 << ((pattern_size - 1) % WORD_BITS);
+
+    // Current and previous state vectors for every number of mismatches
+    vector<uint64_t> state((k + 1) * words, ~(uint64_t) 0);
+    vector<uint64_t> prev_state((k + 1) * words);
+
+    for(int text_pointer = 0; text_pointer < (int) text.size(); text_pointer++) {
+        const uint64_t* mask = &masks[(unsigned char) text[text_pointer] * words];
+        prev_state.swap(state);
+        for(int j = 0; j <= k; j++) {
+            const uint64_t* prev = &prev_state[j * words];
+            const uint64_t* prev_less = j > 0 ? &prev_state[(j - 1) * words] : prev;
+            uint64_t* current = &state[j * words];
+            // Shift in a cleared bit, the empty prefix always matches
+            uint64_t carry = 0;
+            uint64_t carry_less = 0;
+            for(int w = 0; w < words; w++) {
+                uint64_t shifted = (prev[w] << 1) | carry;
+                carry = prev[w] >> (WORD_BITS - 1);
+                current[w] = shifted | mask[w];
+                if(j > 0) {
+                    // Substitute the current character, using one more mismatch
+                    current[w] &= (prev_less[w] << 1) | carry_less;
+                    carry_less = prev_less[w] >> (WORD_BITS - 1);
+                }
+            }
+        }
+        // Lowest number of mismatches where the whole pattern matches
+        for(int j = 0; j <= k; j++) {
+            if(!(state[j * words + last_word] & last_bit)) {
+                matches.push_back({text_pointer - pattern_size + 1, j});
+                break;
+            }
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief Find all end positions where the pattern matches a substring of the text with edit distance
+ * at most k using Myers bit-vector algorithm. The vertical differences of a DP column are stored as the
+ * bitvectors positive (pv) and negative (mv), and a column is advanced one 64-bit block at a time where
+ * the horizontal difference of the block's last row is carried into the next block.
+ * 
+ * @param pattern 
+ * @param text 
+ * @param k Maximum edit distance.
+ * @return vector<pair<int, int>> of (end position, edit distance) for every match.
+ */
+vector<pair<int, int>> find_edit_maches(const string& pattern, const string& text, int k) {
+    vector<pair<int, int>> matches{};
+    int pattern_size = pattern.size();
+    if(pattern_size == 0) {
+        return matches;
+    }
+    int words = (pattern_size + WORD_BITS - 1) / WORD_BITS;
+    vector<uint64_t> masks = char_masks(pattern, words);
+    uint64_t high_bit = (uint64_t) 1 << (WORD_BITS - 1);
+    uint64_t last_bit = (uint64_t) 1 << ((pattern_size - 1) % WORD_BITS);
+
+    vector<uint64_t> pv(words, ~(uint64_t) 0);
+    vector<uint64_t> mv(words, 0);
+    int score = pattern_size;
+
+    for(int text_pointer = 0; text_pointer < (int) text.size(); text_pointer++) {
+        const uint64_t* mask = &masks[(unsigned char) text[text_pointer] * words];
+        // Row 0 is free since a match can start anywhere in the text
+        int h_in = 0;
+        for(int w = 0; w < words; w++) {
+            uint64_t eq = mask[w];
+            uint64_t xv = eq | mv[w];
+            if(h_in < 0) {
+                eq |= 1;
+            }
+            uint64_t xh = (((eq & pv[w]) + pv[w]) ^ pv[w]) | eq;
+            uint64_t ph = mv[w] | ~(xh | pv[w]);
+            uint64_t mh = pv[w] & xh;
+
+            uint64_t top = (w == words - 1) ? last_bit : high_bit;
+            int h_out = 0;
+            if(ph & top) {
+                h_out = 1;
+            } else if(mh & top) {
+                h_out = -1;
+            }
+
+            ph <<= 1;
+            mh <<= 1;
+            if(h_in < 0) {
+                mh |= 1;
+            } else if(h_in > 0) {
+                ph |= 1;
+            }
+            pv[w] = mh | ~(xv | ph);
+            mv[w] = ph & xv;
+            h_in = h_out;
+        }
+        // The last horizontal difference changes the score of the whole pattern
+        score += h_in;
+        if(score <= k) {
+            matches.push_back({text_pointer, score});
+        }
+    }
+    return matches;
+}
+
+int main(int argc, char* argv[]){
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
     cout.tie(NULL);
 
+    // Exact matching if no mode is given
+    string mode = argc > 1 ? argv[1] : "exact";
+    int max_distance = argc > 2 ? atoi(argv[2]) : 0;
+    if(mode != "exact" && mode != "hamming" && mode != "edit") {
+        cerr << "usage: " << argv[0] << " [exact | hamming K | edit K]\n";
+        return 1;
+    }
+
     string pattern, text;
     while(getline(cin, pattern)) {
         if(!getline(cin, text)) {
             break;
         }
-        vector<int> matches = find_maches(pattern, text);
-        for(int match : matches) {
-            cout << match << " ";
+        if(mode == "exact") {
+            vector<int> matches = find_maches(pattern, text);
+            for(int match : matches) {
+                cout << match << " ";
+            } cout << "\n";
+            continue;
+        }
+
+        vector<pair<int, int>> matches;
+        if(mode == "hamming") {
+            matches = find_mismatch_maches(pattern, text, max_distance);
+        } else {
+            matches = find_edit_maches(pattern, text, max_distance);
+        }
+        for(auto match : matches) {
+            cout << match.first << ":" << match.second << " ";
         } cout << "\n";
     }
 }
\ No newline at end of file
@@ -2,65 +2,150 @@
 #include <vector>
 #include <algorithm>
 #include <string>
-#include <cmath>
+#include <cstdint>
+#include <charconv>
+#include <cstring>
 using namespace std;
 
-bool is_triange(pair<int,int> a, pair<int,int> b, pair<int,int> c) {
-    if((a == b) || (b == c) || (a == c)) {
-        return false;
-    }
+/**
+ * @brief Point with integer coordinates.
+ */
+struct Point {
+    int64_t x;
+    int64_t y;
+};
 
-    if((b.second - a.second) * (c.first - b.first) == (c.second - b.second) * (b.first - a.first)) {
-        return false;
-    }
+/**
+ * @brief Vector between two points.
+ */
+struct Vec {
+    int64_t x;
+    int64_t y;
+};
+
+Vec operator-(Point a, Point b) {
+    return Vec{a.x - b.x, a.y - b.y};
+}
+
+int64_t dot(Vec a, Vec b) {
+    return a.x * b.x + a.y * b.y;
+}
 
-    return true;
+/**
+ * @brief Exact orientation of three integer points, the products are done in 128 bits so it works for
+ * all coordinates below 2^62.
+ *
+ * @param a
+ * @param b
+ * @param c
+ * @return int 1 if a, b, c turn counterclockwise, -1 if clockwise and 0 if they are on a line.
+ */
+int orientation(Point a, Point b, Point c) {
+    __int128 det = (__int128) (b.x - a.x) * (c.y - a.y) - (__int128) (b.y - a.y) * (c.x - a.x);
+    return (det > 0) - (det < 0);
+}
+
+/**
+ * @brief Read the next integer from the buffer. The buffer ends with a 0 character (like the data of a
+ * string), so there is no need to check the length for every character.
+ *
+ * @param pos Position in the buffer, moved past the integer.
+ * @return int64_t, 0 at the end of the buffer.
+ */
+int64_t read_int(const char*& pos) {
+    while(*pos != '-' && (unsigned) (*pos - '0') > 9 && *pos != 0) {
+        pos++;
+    }
+    bool negative = *pos == '-';
+    if(negative) {
+        pos++;
+    }
+    int64_t number = 0;
+    while((unsigned) (*pos - '0') <= 9) {
+        number = number * 10 + (*pos - '0');
+        pos++;
+    }
+    return negative ? -number : number;
 }
 
-string get_angle(vector<int> lengths) {
-    if(lengths[0] + lengths[1] == lengths[2]) {
-        return "right";
-    } else if(lengths[0] + lengths[1] > lengths[2]) {
-        return "acute";
-    } else {
-        return "obtuse";
+// Triangles classified at a time, small enough for the coordinates to stay in cache
+constexpr int BATCH_SIZE = 4096;
+// Answer for every code from classify_triangles
+const string ANSWERS[7] = {
+    "scalene acute triangle", "scalene right triangle", "scalene obtuse triangle",
+    "isosceles acute triangle", "isosceles right triangle", "isosceles obtuse triangle",
+    "not a triangle"
+};
+
+/**
+ * @brief Classify triangles without branches. The points are not on a line when their orientation is not
+ * 0. The biggest angle is right or obtuse when the smallest dot product of the two sides at a corner is
+ * 0 or negative (the same as comparing the squared sides with pythagoras), and the triangle is isosceles
+ * when two squared sides are equal. Coordinates must be below 2^30 so nothing overflows.
+ *
+ * @param coordinates x and y of the three points of every triangle, packed one triangle after another.
+ * @param count Number of triangles.
+ * @param codes Set to isosceles * 3 + angle (0 acute, 1 right, 2 obtuse), or 6 if not a triangle.
+ */
+void classify_triangles(const int64_t* coordinates, int count, uint8_t* codes) {
+    for(int i = 0; i < count; i++) {
+        const int64_t* triangle = coordinates + 6 * i;
+        Point a{triangle[0], triangle[1]};
+        Point b{triangle[2], triangle[3]};
+        Point c{triangle[4], triangle[5]};
+        Vec ab = b - a, bc = c - b, ca = a - c;
+
+        int64_t smallest = min(min(-dot(ca, ab), -dot(ab, bc)), -dot(bc, ca));
+        int64_t length_ab = dot(ab, ab), length_bc = dot(bc, bc), length_ca = dot(ca, ca);
+
+        int angle = (smallest == 0) + 2 * (smallest < 0);
+        int isosceles = (length_ab == length_bc) | (length_bc == length_ca) | (length_ab == length_ca);
+        int is_triangle = orientation(a, b, c) != 0;
+        codes[i] = is_triangle * (isosceles * 3 + angle) + (1 - is_triangle) * 6;
     }
 }
 
+/**
+ * @brief Reads all triangles at once, classifies them BATCH_SIZE at a time and writes the answers of
+ * every batch to one buffer.
+ */
 int main(){
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
     cout.tie(NULL);
 
-    int test_cases;
-    cin >> test_cases;
-    for(int test = 0; test < test_cases; test++) {
-        int x, y;
-        vector<pair<int, int>> points;
-        for(int i = 0; i < 3; i++) {
-            cin >> x >> y;
-            points.push_back({x, y});
-        }
-        
-        if(!is_triange(points[0], points[1], points[2])) {
-            cout << "Case #" << (test +1) << ": not a triangle\n";
-            continue;
-        }
-
-        vector<int> lengths;    
-        lengths.push_back(pow(points[0].first - points[1].first, 2) + pow(points[0].second - points[1].second, 2));
-        lengths.push_back(pow(points[1].first - points[2].first, 2) + pow(points[1].second - points[2].second, 2));
-        lengths.push_back(pow(points[0].first - points[2].first, 2) + pow(points[0].second - points[2].second, 2));
-
-        sort(lengths.begin(), lengths.end());
-
-        string angle = get_angle(lengths);
-        string triangle_type = "scalene";
+    // Read in big blocks, much faster than going through the stream one character at a time
+    string input;
+    char block[1 << 16];
+    streamsize block_size;
+    while((block_size = cin.rdbuf()->sgetn(block, sizeof(block))) > 0) {
+        input.append(block, block_size);
+    }
+    const char* pos = input.c_str();
+    int test_cases = read_int(pos);
 
-        if(lengths[0] == lengths[1] || lengths[1] == lengths[2] || lengths[0] == lengths[2]) {
-            triangle_type = "isosceles";
+    vector<int64_t> coordinates(6 * BATCH_SIZE);
+    vector<uint8_t> codes(BATCH_SIZE);
+    // Longest line is "Case #" + 10 digits + ": " + the longest answer + newline
+    vector<char> output(BATCH_SIZE * 64);
+    for(int first = 0; first < test_cases; first += BATCH_SIZE) {
+        int count = min(BATCH_SIZE, test_cases - first);
+        for(int i = 0; i < 6 * count; i++) {
+            coordinates[i] = read_int(pos);
         }
+        classify_triangles(coordinates.data(), count, codes.data());
 
-        cout << "Case #" << (test + 1) << ": " << triangle_type << " " << angle << " triangle\n";
+        char* out = output.data();
+        for(int i = 0; i < count; i++) {
+            memcpy(out, "Case #", 6);
+            out = to_chars(out + 6, out + 16, first + i + 1).ptr;
+            *out++ = ':';
+            *out++ = ' ';
+            const string& answer = ANSWERS[codes[i]];
+            memcpy(out, answer.data(), answer.size());
+            out += answer.size();
+            *out++ = '\n';
+        }
+        cout.write(output.data(), out - output.data());
     }
-}
\ No newline at end of file
+}
@@ -1,109 +1,161 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <string>
+#include <iterator>
+#include <cctype>
+#include <cstdlib>
 using namespace std;
 
-
-int main(){
-    ios_base::sync_with_stdio(false);
-    cin.tie(NULL);
-    cout.tie(NULL);
-    
-    vector<vector<int>> FLIP_OUTCOMES = {
-        vector<int>{0b001, 0b010, 0b100}, // 0b000
-        vector<int>{0b000, 0b011, 0b101}, // 0b001
-        vector<int>{0b000, 0b011, 0b110}, // 0b010
-        vector<int>{0b010, 0b001, 0b111}, // 0b011
-        vector<int>{0b101, 0b110, 0b000}, // 0b100
-        vector<int>{0b100, 0b111, 0b001}, // 0b101
-        vector<int>{0b111, 0b100, 0b010}, // ob110
-        vector<int>{0b110, 0b101, 0b011} //0b111
-    };
-    int rounds;
-    cin >> rounds;
-    // How many test cases/ rounds will go down.
-    for(int i = 0; i < rounds; i++) {
-        int priests;
-        cin >> priests;
-        // Initiate all grid values to 0 at first
-        vector<vector<int>> stone_outputs(priests, vector<int>(8, -1));
-        vector<int> temp;
-        for(int n = 0; n < 8; n++) {
-            temp.push_back(n);
+/**
+ * @brief Table of the stone states reachable by flipping one of the stones, for every state.
+ *
+ * @tparam STONES Number of stones.
+ * @return array of 2^STONES rows with the STONES states one flip away.
+ */
+template<int STONES>
+constexpr array<array<int, STONES>, (1 << STONES)> make_flip_outcomes() {
+    array<array<int, STONES>, (1 << STONES)> outcomes{};
+    for(int state = 0; state < (1 << STONES); state++) {
+        for(int stone = 0; stone < STONES; stone++) {
+            outcomes[state][stone] = state ^ (1 << stone);
         }
-        stone_outputs.push_back(temp);
+    }
+    return outcomes;
+}
+
+/**
+ * @brief Read the next non negative integer from the buffer.
+ *
+ * @param buffer
+ * @param pos Position in buffer, moved past the integer.
+ * @return int
+ */
+int read_int(const string& buffer, size_t& pos) {
+    while(pos < buffer.size() && !isdigit((unsigned char) buffer[pos])) {
+        pos++;
+    }
+    int number = 0;
+    while(pos < buffer.size() && isdigit((unsigned char) buffer[pos])) {
+        number = number * 10 + (buffer[pos] - '0');
+        pos++;
+    }
+    return number;
+}
 
-        vector<vector<int>> choices;
-        // One priest at a time.
-        for(int priest = 0; priest < priests; priest++) {
-            vector<int> temp_choice(8,0);
-            // Get the priests prefered answers
-            for(int k = 0; k < 8; k++){
-                int choice;
-                cin >> choice;
-                temp_choice[k] = choice-1;
+/**
+ * @brief Work backward over the priests to find the final stones when starting with all stones down.
+ * Only the outcomes of the next priest are needed, so two flat arrays of 2^STONES entries are used.
+ *
+ * @tparam STONES Number of stones, the flips come from the constexpr table.
+ * @param ranks Preference of every priest for every outcome (lower is better), 2^STONES per priest.
+ * @param priests Number of priests.
+ * @return int final state of the stones.
+ */
+template<int STONES>
+int vote(const int* ranks, int priests) {
+    constexpr int STATES = 1 << STONES;
+    constexpr array<array<int, STONES>, STATES> flip_outcomes = make_flip_outcomes<STONES>();
+    // What the stones end as, for every state the next priest gets them in
+    array<int, STATES> next_outputs;
+    for(int state = 0; state < STATES; state++) {
+        next_outputs[state] = state;
+    }
+    array<int, STATES> stone_outputs;
+    for(int priest = priests - 1; priest >= 0; priest--) {
+        const int* choice = ranks + priest * STATES;
+        for(int stone_input = 0; stone_input < STATES; stone_input++) {
+            // Find best output choice
+            int best_choice = -1;
+            int best_index = STATES;
+            for(int flip_value : flip_outcomes[stone_input]) {
+                int prev_priest_choice = next_outputs[flip_value];
+                int index = choice[prev_priest_choice];
+                if(index < best_index) {
+                    best_index = index;
+                    best_choice = prev_priest_choice;
+                }
             }
-            choices.push_back(temp_choice);
+            stone_outputs[stone_input] = best_choice;
         }
+        next_outputs = stone_outputs;
+    }
+    return next_outputs[0];
+}
 
-        for(int priest = priests-1; priest >= 0; priest--){
-            // Fill out what priest will output for what input (input/output in binary 3 stones)
-            
-            for(int stone_input = 0; stone_input < 8; stone_input++){ // Stone combination    // Find best output choice
-                int best_choice = -1;
-                int best_index = 16;
-                for(int flip_value : FLIP_OUTCOMES[stone_input]) {
-                    vector<int> choice_vector = choices[priest];
-                    int prev_priest_choice = stone_outputs[priest+1][flip_value];
-                    // auto iter = find(choice_vector.begin(), choice_vector.end(), prev_priest_choice);
-                    // int index = iter - choice_vector.begin();
-                    int index = choice_vector[prev_priest_choice];
-                    if(index < best_index) {
-                        best_index = index;
-                        best_choice = prev_priest_choice;
-                    }
+/**
+ * @brief Same as vote but for any number of stones given at runtime, flips are done with xor.
+ *
+ * @param ranks Preference of every priest for every outcome (lower is better), 2^stones per priest.
+ * @param priests Number of priests.
+ * @param stones Number of stones.
+ * @return int final state of the stones.
+ */
+int vote(const int* ranks, int priests, int stones) {
+    int states = 1 << stones;
+    vector<int> next_outputs(states);
+    vector<int> stone_outputs(states);
+    for(int state = 0; state < states; state++) {
+        next_outputs[state] = state;
+    }
+    for(int priest = priests - 1; priest >= 0; priest--) {
+        const int* choice = ranks + (long) priest * states;
+        for(int stone_input = 0; stone_input < states; stone_input++) {
+            int best_choice = -1;
+            int best_index = states;
+            for(int stone = 0; stone < stones; stone++) {
+                int prev_priest_choice = next_outputs[stone_input ^ (1 << stone)];
+                int index = choice[prev_priest_choice];
+                if(index < best_index) {
+                    best_index = index;
+                    best_choice = prev_priest_choice;
                 }
-                stone_outputs[priest][stone_input] = best_choice;
             }
+            stone_outputs[stone_input] = best_choice;
         }
+        next_outputs.swap(stone_outputs);
+    }
+    return next_outputs[0];
+}
+
+/**
+ * @brief Reads all rounds at once and writes all answers in one buffer. The number of stones can be
+ * given as argument (3 by default), every priest then ranks all 2^stones outcomes. Each answer is the
+ * stones from the highest bit down, Y for up and N for down.
+ */
+int main(int argc, char* argv[]){
+    ios_base::sync_with_stdio(false);
+    cin.tie(NULL);
+    cout.tie(NULL);
+
+    int stones = argc > 1 ? atoi(argv[1]) : 3;
+    if(stones < 1 || stones > 20) {
+        cerr << "usage: " << argv[0] << " [stones]\n";
+        return 1;
+    }
+    int states = 1 << stones;
 
-        // cout << endl;
-        // for(auto i: stone_outputs){
-        //     for(auto n : i) {
-        //         cout << n << " ";
-        //     }
-        //     cout << endl;
-        // }
+    string input(istreambuf_iterator<char>(cin), {});
+    size_t pos = 0;
+    string output;
+    vector<int> ranks;
 
-        int out = stone_outputs[0][0];
+    int rounds = read_int(input, pos);
+    // How many test cases/ rounds will go down.
+    for(int i = 0; i < rounds; i++) {
+        int priests = read_int(input, pos);
+        // Get the priests prefered answers, one flat row per priest
+        ranks.resize((long) priests * states);
+        for(int& rank : ranks) {
+            rank = read_int(input, pos) - 1;
+        }
 
-        switch (out) {
-            case 0:
-                cout << "NNN\n";
-                break;
-            case 1:
-                cout << "NNY\n";
-                break;
-            case 2:
-                cout << "NYN\n";
-                break;
-            case 3:
-                cout << "NYY\n";
-                break;
-            case 4:
-                cout << "YNN\n";
-                break; 
-            case 5:
-                cout << "YNY\n";
-                break;
-            case 6:
-                cout << "YYN\n";
-                break;
-            case 7:
-                cout << "YYY\n";
-                break;
-            default:
-                break;
+        int out = stones == 3 ? vote<3>(ranks.data(), priests) : vote(ranks.data(), priests, stones);
+        for(int stone = stones - 1; stone >= 0; stone--) {
+            output += ((out >> stone) & 1) ? 'Y' : 'N';
         }
+        output += '\n';
     }
-}
\ No newline at end of file
+    cout << output;
+}
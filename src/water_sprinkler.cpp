@@ -1,94 +1,147 @@
 // Includes
 #include <vector>
 #include <iostream>
-#include <tuple>
 #include <algorithm>
-#include <cfloat>
+#include <cstdint>
+#include <cstring>
 #include <cmath>
 using namespace std;
 
 /**
- * @brief Compares two tuples to find who has larger first value.
- * 
- * @param i1 Tuple of type double, double,  int 
- * @param i2 Tuple of type double, double,  int
- * @return true if i1 has larger first value.
- * @return false otherwise
+ * @brief Intervals stored as separate arrays of starts, ends and ids (struct of arrays). The buffers are
+ * kept between test cases with clear, so only the first test cases allocate memory.
  */
-bool interval_compare(tuple<double, double, int>& i1, tuple<double, double, int>& i2) {
-    return (get<0>(i1) < get<0>(i2));
-}
-
-/**
- * @brief A greedy approch to find minimal amount of intervals to cover a given interval.
- * 
- * @param interval tuple of double, double, int - interval to be check.
- * @param intervals vector of intervals of type tuple: double, double, int.
- * @return vector<int> of which indexes of original intervals vector that are needed to cover interval. 
- *  First value -1 if impossible. 
- */
-vector<int> count_intervals(tuple<double, double> interval, vector<tuple<double, double, int>> intervals) {
-    // Initiate variables
-    double primary_start = get<0>(interval);
-    double primary_end = get<1>(interval);
-    double start = primary_start;
-    double end = start - 1;
-    vector<int> indexes;
+class IntervalCover {
+public:
+    /**
+     * @brief Remove all intervals but keep the buffers.
+     */
+    void clear() {
+        starts.clear();
+        ends.clear();
+        ids.clear();
+    }
 
-    // Sort interval with complexity O(NlogN) on start value (of tuple).
-    sort(intervals.begin(), intervals.end(), interval_compare);
+    /**
+     * @brief Add an interval.
+     * 
+     * @param start 
+     * @param end 
+     * @param id Index printed when the interval is used.
+     */
+    void add(double start, double end, int id) {
+        starts.push_back(start);
+        ends.push_back(end);
+        ids.push_back(id);
+    }
 
-    // Padding to not go outside boundaries.
-    intervals.push_back(make_tuple(DBL_MAX, DBL_MAX, -1));
-    
-    int index = -1;
-    // Main loop checking all intervals.
-    for (unsigned i = 0; i < intervals.size();) {
-        tuple<double, double, int> new_interval = intervals[i];
-        double new_start = get<0>(new_interval);
-        double new_end = get<1>(new_interval);
+    /**
+     * @brief A greedy approch to find minimal amount of intervals to cover a given interval. The intervals
+     * are gone through in order of start, every time the next one starts after the covered part the
+     * interval reaching furthest so far is used. O(N) after the radix sort.
+     * 
+     * @param primary_start Start of interval to be covered.
+     * @param primary_end End of interval to be covered.
+     * @return const vector<int>& of which ids that are needed to cover interval. First value -1 if impossible.
+     */
+    const vector<int>& count_intervals(double primary_start, double primary_end) {
+        sort_on_start();
+        double start = primary_start;
+        double end = start - 1;
+        indexes.clear();
 
-        // Update end, is it a better interval or worse?
-        if (new_start <= start) {
-            // Only update if new end is better (higher)
-            if (new_end > end) {
-                end = new_end;
-                index = get<2>(new_interval);
+        int index = -1;
+        size_t i = 0;
+        // Main loop checking all intervals.
+        while(true) {
+            if(i < order.size() && starts[order[i]] <= start) {
+                // Only update if new end is better (higher)
+                if(ends[order[i]] > end) {
+                    end = ends[order[i]];
+                    index = ids[order[i]];
+                }
+                i++;
+            } else {
+                // Current interval doesn't cover the start, need a new interval
+                start = end;
+                if (index != -1) { indexes.push_back(index);}
+                // End of loop, impossible or done
+                if (i == order.size() || starts[order[i]] > end || end >= primary_end) {
+                    break;
+                }
             }
-            i++;
-        } else {
-            // Current interval doesn't cover the start, need a new interval
-            start = end;
+        }
 
-            if (index != -1) { indexes.push_back(index);}
-            // End of loop, impossible or done
-            if (new_start > end || end >= primary_end) {
-                break;
-            }
+        if (end < primary_end) {
+            // Can't find valid intervals to cover interval.
+            indexes.assign(1, -1);
         }
+        return indexes;
     }
 
-    // Returns
-    if (end < primary_end) {
-        // Can't find valid intervals to cover interval.
-        vector<int> invalid = {-1};
-        return invalid;
+private:
+    vector<double> starts;
+    vector<double> ends;
+    vector<int> ids;
+    // Positions of the intervals in order of start, and buffers for the radix sort
+    vector<int> order;
+    vector<int> order_buffer;
+    vector<uint64_t> keys;
+    vector<uint64_t> key_buffer;
+    vector<int> indexes;
+
+    /**
+     * @brief Sort the positions on start with a LSD radix sort, 8 bits at a time, in O(N). The doubles are
+     * turned into integers with the same order: negative numbers get all bits flipped, positive numbers
+     * only the sign bit. Passes where all keys have the same byte are skipped. The sort is stable, so
+     * intervals with the same start keep their input order.
+     */
+    void sort_on_start() {
+        size_t size = starts.size();
+        keys.resize(size);
+        key_buffer.resize(size);
+        order.resize(size);
+        order_buffer.resize(size);
+        for(size_t i = 0; i < size; i++) {
+            uint64_t bits;
+            memcpy(&bits, &starts[i], sizeof(bits));
+            keys[i] = (bits >> 63) ? ~bits : bits | ((uint64_t) 1 << 63);
+            order[i] = i;
+        }
+        for(int shift = 0; shift < 64; shift += 8) {
+            size_t counts[257] = {0};
+            for(size_t i = 0; i < size; i++) {
+                counts[((keys[i] >> shift) & 0xff) + 1]++;
+            }
+            if(size == 0 || counts[((keys[0] >> shift) & 0xff) + 1] == size) {
+                continue;
+            }
+            for(int digit = 0; digit < 256; digit++) {
+                counts[digit + 1] += counts[digit];
+            }
+            for(size_t i = 0; i < size; i++) {
+                size_t to = counts[(keys[i] >> shift) & 0xff]++;
+                key_buffer[to] = keys[i];
+                order_buffer[to] = order[i];
+            }
+            keys.swap(key_buffer);
+            order.swap(order_buffer);
+        }
     }
-    
-    return indexes;
-}
+};
 
 int main(){
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
     cout.tie(NULL);
 
+    IntervalCover intervals;
     double num_circles, grass_length, grass_width;
     while(cin >> num_circles >> grass_length >> grass_width) {
         double half_grass_width = grass_width/2;
         double position, radius;
-        // Create intervals vector
-        vector<tuple<double, double, int>> intervals;
+        // Fill the intervals, reusing the buffers of the last test case
+        intervals.clear();
         for(int i = 0; i < num_circles; i++) {
             cin >> position >> radius;
             double start_interval;
@@ -104,12 +157,10 @@ int main(){
             }
             //cout << "start: " << start_interval << " end: " << end_interval << "\n";
 
-            tuple<double, double> interval = make_tuple(start_interval, end_interval);
-            intervals.push_back(make_tuple(start_interval, end_interval, i));
+            intervals.add(start_interval, end_interval, i);
         }
         // Find number of counts
-        tuple<double, double> interval = make_tuple(0, grass_length);
-        vector<int> interval_count = count_intervals(interval, intervals);
+        const vector<int>& interval_count = intervals.count_intervals(0, grass_length);
         
         // Print results
         if (interval_count.size() != 0 && interval_count.front() == -1) {